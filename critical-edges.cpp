@@ -1,9 +1,61 @@
-// O(m+n) - DFS traversal
+// O(m+n) - DFS traversal, which also labels the 2-edge-connected components
+// and builds the bridge tree
+// O(1) per query - whether removing an edge disconnects two nodes
 #include <bits/stdc++.h>
 using namespace std;
 
 
-void detectCriticalEdges(int currentNode, const vector<vector<int>> &adjacencyList, bool *isVisited, int *level, int *minimumLevel, int *parentOf) {
+// buffered reader for large inputs: the file is read in blocks of 64KB,
+// instead of parsing one token at a time through 'ifstream'
+struct InputReader {
+    FILE *file;
+    char buffer[1 << 16];
+    int size = 0, position = 0;
+
+    explicit InputReader(const char *fileName) : file(fopen(fileName, "r")) {}
+
+    ~InputReader() {
+        if (file)
+            fclose(file);
+    }
+
+    int nextCharacter() {
+        if (position == size) {
+            size = (int) fread(buffer, 1, sizeof(buffer), file);
+            position = 0;
+            if (size <= 0)
+                return EOF;
+        }
+        return (unsigned char) buffer[position++];
+    }
+
+    // returns false once the end of the file is reached
+    bool readInt(int &value) {
+        int character = nextCharacter();
+        while (character != EOF and character != '-' and not isdigit(character))
+            character = nextCharacter();
+        if (character == EOF)
+            return false;
+
+        bool isNegative = character == '-';
+        if (isNegative)
+            character = nextCharacter();
+
+        value = 0;
+        for (; character != EOF and isdigit(character); character = nextCharacter())
+            value = value * 10 + (character - '0');
+        if (isNegative)
+            value = -value;
+
+        return true;
+    }
+};
+
+
+// recursive version, which only collects the bridges (as pairs of nodes); its depth grows
+// with the longest DFS path, so large graphs go through 'decomposeByBridges' instead
+void detectCriticalEdges(int currentNode, const vector<vector<int>> &adjacencyList, bool *isVisited, int *level, int *minimumLevel, int *parentOf,
+                         vector<pair<int, int>> &bridges) {
     isVisited[currentNode] = true;
 
     for (auto &adjacentNode: adjacencyList[currentNode]) {
@@ -12,7 +64,7 @@ void detectCriticalEdges(int currentNode, const vector<vector<int>> &adjacencyLi
             level[adjacentNode] = level[currentNode] + 1;
             minimumLevel[adjacentNode] = level[currentNode] + 1;
 
-            detectCriticalEdges(adjacentNode, adjacencyList, isVisited, level, minimumLevel, parentOf);
+            detectCriticalEdges(adjacentNode, adjacencyList, isVisited, level, minimumLevel, parentOf, bridges);
 
             // check if the subtree rooted with v is
             // connected to one of the ancestors of u
@@ -23,7 +75,7 @@ void detectCriticalEdges(int currentNode, const vector<vector<int>> &adjacencyLi
             // under v is below u in DFS tree, then u-v
             // is critical
             if (minimumLevel[adjacentNode] > level[currentNode])
-                cout << currentNode + 1 << " " << adjacentNode + 1 << '\n';
+                bridges.emplace_back(currentNode, adjacentNode);
         }
         // Update low value of u for parent function calls
         else if (adjacentNode != parentOf[currentNode]) {
@@ -34,47 +86,224 @@ void detectCriticalEdges(int currentNode, const vector<vector<int>> &adjacencyLi
 }
 
 
+struct BridgeDecomposition {
+    int numberOfNodes, numberOfComponents;
+    // the graph, as a compressed list of incident edges: the edges incident to 'node' are
+    // 'incidentEdges[firstEdgeOf[node]]', ..., 'incidentEdges[firstEdgeOf[node + 1] - 1]';
+    // the other endpoint of an edge is found through its endpoints, so that
+    // no adjacent node has to be stored next to the edge index
+    vector<pair<int, int>> edges;
+    vector<int> firstEdgeOf, incidentEdges;
+
+    // DFS entry and exit times of every node, which describe its subtree
+    vector<int> entryTime, exitTime;
+    // first node of the DFS tree containing every node
+    vector<int> rootOf;
+    vector<bool> isBridge;
+    vector<int> bridges;
+    // 2-edge-connected component of every node
+    vector<int> componentOf;
+    // bridge tree: one node per 2-edge-connected component, one (parent, child) edge per bridge
+    vector<pair<int, int>> bridgeTreeEdges;
+};
+
+
+void buildIncidenceLists(int numberOfNodes, BridgeDecomposition &decomposition) {
+    auto &firstEdgeOf = decomposition.firstEdgeOf;
+    int numberOfEdges = (int) decomposition.edges.size();
+
+    firstEdgeOf.assign(numberOfNodes + 1, 0);
+
+    // self-loops are only stored once
+    for (auto &edge: decomposition.edges) {
+        firstEdgeOf[edge.first + 1]++;
+        if (edge.second != edge.first)
+            firstEdgeOf[edge.second + 1]++;
+    }
+    for (int node = 0; node < numberOfNodes; node++)
+        firstEdgeOf[node + 1] += firstEdgeOf[node];
+
+    decomposition.incidentEdges.resize(firstEdgeOf[numberOfNodes]);
+    vector<int> nextPosition(firstEdgeOf.begin(), firstEdgeOf.end() - 1);
+    for (int edge = 0; edge < numberOfEdges; edge++) {
+        decomposition.incidentEdges[nextPosition[decomposition.edges[edge].first]++] = edge;
+        if (decomposition.edges[edge].second != decomposition.edges[edge].first)
+            decomposition.incidentEdges[nextPosition[decomposition.edges[edge].second]++] = edge;
+    }
+}
+
+
+// iterative DFS, which finds the bridges and the 2-edge-connected components;
+// 'decomposition.edges' must hold the edges of the graph
+void decomposeByBridges(int numberOfNodes, BridgeDecomposition &decomposition) {
+    auto &d = decomposition;
+    d.numberOfNodes = numberOfNodes;
+    buildIncidenceLists(numberOfNodes, d);
+
+    d.entryTime.assign(numberOfNodes, -1);
+    d.exitTime.assign(numberOfNodes, -1);
+    d.rootOf.assign(numberOfNodes, -1);
+    d.componentOf.assign(numberOfNodes, -1);
+    d.isBridge.assign(d.edges.size(), false);
+    d.bridges.clear();
+    d.bridgeTreeEdges.clear();
+    d.numberOfComponents = 0;
+
+    // smallest entry time reachable from the subtree of every node through a single non-tree edge
+    vector<int> minimumEntryTime(numberOfNodes), parentEdgeOf(numberOfNodes, -1);
+    // the current DFS path, as (node, position of the next incident edge) pairs
+    vector<pair<int, int>> stack;
+    // visited nodes whose 2-edge-connected component is not yet complete
+    vector<int> nodeStack;
+
+    int time = 0;
+    for (int root = 0; root < numberOfNodes; root++) {
+        if (d.entryTime[root] != -1)
+            continue;
+
+        d.rootOf[root] = root;
+        d.entryTime[root] = minimumEntryTime[root] = time++;
+        nodeStack.push_back(root);
+        stack.emplace_back(root, d.firstEdgeOf[root]);
+
+        while (not stack.empty()) {
+            int currentNode = stack.back().first;
+            int &position = stack.back().second;
+
+            if (position < d.firstEdgeOf[currentNode + 1]) {
+                int edge = d.incidentEdges[position++];
+                int adjacentNode = d.edges[edge].first ^ d.edges[edge].second ^ currentNode;
+
+                // only the tree edge itself is skipped, so parallel edges count as back edges
+                if (edge == parentEdgeOf[currentNode])
+                    continue;
+
+                if (d.entryTime[adjacentNode] == -1) {
+                    parentEdgeOf[adjacentNode] = edge;
+                    d.rootOf[adjacentNode] = root;
+                    d.entryTime[adjacentNode] = minimumEntryTime[adjacentNode] = time++;
+                    nodeStack.push_back(adjacentNode);
+                    stack.emplace_back(adjacentNode, d.firstEdgeOf[adjacentNode]);
+                } else
+                    minimumEntryTime[currentNode] = min(minimumEntryTime[currentNode], d.entryTime[adjacentNode]);
+
+                continue;
+            }
+
+            // every incident edge was checked, so the traversal returns to the parent node
+            stack.pop_back();
+            d.exitTime[currentNode] = time - 1;
+
+            // no edge leaves the subtree of the current node, other than its tree edge,
+            // so the nodes of the subtree still on the node stack form a component
+            if (minimumEntryTime[currentNode] == d.entryTime[currentNode]) {
+                int component = d.numberOfComponents++, node;
+                do {
+                    node = nodeStack.back();
+                    nodeStack.pop_back();
+                    d.componentOf[node] = component;
+                } while (node != currentNode);
+            }
+
+            if (currentNode == root)
+                continue;
+
+            int parentEdge = parentEdgeOf[currentNode];
+            int parent = d.edges[parentEdge].first ^ d.edges[parentEdge].second ^ currentNode;
+            minimumEntryTime[parent] = min(minimumEntryTime[parent], minimumEntryTime[currentNode]);
+
+            // if the lowest node reachable from the subtree of the current node
+            // is below its parent in the DFS tree, then the tree edge is critical
+            if (minimumEntryTime[currentNode] > d.entryTime[parent]) {
+                d.isBridge[parentEdge] = true;
+                d.bridges.push_back(parentEdge);
+            }
+        }
+    }
+
+    // the bridge tree follows the DFS tree: the component below a bridge is the child
+    // of the one above it (components are only complete once the traversal is done)
+    for (auto edge: d.bridges) {
+        int firstNode = d.edges[edge].first, secondNode = d.edges[edge].second;
+        if (d.entryTime[firstNode] > d.entryTime[secondNode])
+            swap(firstNode, secondNode);
+
+        d.bridgeTreeEdges.emplace_back(d.componentOf[firstNode], d.componentOf[secondNode]);
+    }
+}
+
+
+bool isInSubtree(const BridgeDecomposition &decomposition, int subtreeRoot, int node) {
+    return decomposition.entryTime[subtreeRoot] <= decomposition.entryTime[node] and
+           decomposition.entryTime[node] <= decomposition.exitTime[subtreeRoot];
+}
+
+
+// O(1) - whether removing 'edge' disconnects 'firstNode' from 'secondNode' (which must be
+// connected beforehand); only a bridge may do so, and it separates exactly the subtree
+// below it (in the DFS tree, and therefore in the bridge tree as well) from the rest
+bool disconnects(const BridgeDecomposition &decomposition, int edge, int firstNode, int secondNode) {
+    if (not decomposition.isBridge[edge] or decomposition.rootOf[firstNode] != decomposition.rootOf[secondNode])
+        return false;
+
+    int lowerNode = decomposition.edges[edge].first, upperNode = decomposition.edges[edge].second;
+    if (decomposition.entryTime[lowerNode] < decomposition.entryTime[upperNode])
+        swap(lowerNode, upperNode);
+
+    return isInSubtree(decomposition, lowerNode, firstNode) != isInSubtree(decomposition, lowerNode, secondNode);
+}
+
+
 int main() {
-    ifstream input("graf.in");
+    InputReader input("graf.in");
+    if (not input.file) {
+        cerr << "can't open graf.in\n";
+        return 1;
+    }
 
     int numberOfNodes, numberOfEdges;
-    input >> numberOfNodes >> numberOfEdges;
+    input.readInt(numberOfNodes);
+    input.readInt(numberOfEdges);
 
-    vector<vector<int>> adjacencyList(numberOfNodes, vector<int>());
+    BridgeDecomposition decomposition;
+    decomposition.edges.resize(numberOfEdges);
     int firstNode, secondNode;
     for (int i = 0; i < numberOfEdges; i++) {
-        input >> firstNode >> secondNode;
-        firstNode--;
-        secondNode--;
-
-        adjacencyList[firstNode].push_back(secondNode);
-        adjacencyList[secondNode].push_back(firstNode);
+        input.readInt(firstNode);
+        input.readInt(secondNode);
+        decomposition.edges[i] = {firstNode - 1, secondNode - 1};
     }
 
-    input.close();
+    decomposeByBridges(numberOfNodes, decomposition);
+
+    for (auto edge: decomposition.bridges)
+        cout << decomposition.edges[edge].first + 1 << " " << decomposition.edges[edge].second + 1 << '\n';
 
-    bool isVisited[numberOfNodes];
-    int level[numberOfNodes], minimumLevel[numberOfNodes], parentOf[numberOfNodes];
+    // optional edge failure queries: their number, followed by 'e u v' triplets,
+    // 'e' being the index of an edge in the input - does removing e disconnect u from v?
+    int numberOfQueries = 0, edge;
+    input.readInt(numberOfQueries);
 
-    // initialize parent and visited arrays
-    for (int i = 0; i < numberOfNodes; i++) {
-        parentOf[i] = -1;
-        isVisited[i] = false;
+    string answers;
+    for (int i = 0; i < numberOfQueries; i++) {
+        input.readInt(edge);
+        input.readInt(firstNode);
+        input.readInt(secondNode);
+        answers += disconnects(decomposition, edge - 1, firstNode - 1, secondNode - 1) ? "YES\n" : "NO\n";
     }
+    cout << answers;
 
-    // traverse all DFS trees
+    // graf.out: the number of 2-edge-connected components, the component of every node,
+    // then the edges of the bridge tree, as (parent, child) pairs of components
+    ofstream output("graf.out");
+    output << decomposition.numberOfComponents << '\n';
+    string line;
     for (int node = 0; node < numberOfNodes; node++)
-        if (not isVisited[node]) {
-            level[node] = 0;
-            minimumLevel[node] = 0;
-
-            detectCriticalEdges(node, adjacencyList, isVisited, level, minimumLevel, parentOf);
-        }
-
-//    // display edges in tree
-//    for (int node = 0; node < numberOfNodes; node++)
-//        if (parentOf[node] != -1)
-//            cout << node + 1 << ' ' << parentOf[node] + 1;
+        line += to_string(decomposition.componentOf[node] + 1) + (node + 1 < numberOfNodes ? ' ' : '\n');
+    output << line;
+    for (auto &treeEdge: decomposition.bridgeTreeEdges)
+        output << treeEdge.first + 1 << ' ' << treeEdge.second + 1 << '\n';
+    output.close();
 
     return 0;
 }
@@ -1,8 +1,13 @@
 // C++ program to find articulation points in an undirected graph
+// O(m+n) - iterative DFS traversal, which also splits the edges into biconnected
+// components (blocks) and builds the block-cut tree
+// O(n*log(n)) - preprocessing of the block-cut tree for O(1) LCA queries, used to
+// answer whether two nodes remain connected after a node fails in O(1) per query
 #include <bits/stdc++.h>
 using namespace std;
 
 
+// recursive version, which only marks the articulation points
 void detectCriticalNodes(int currentNode, const vector<vector<int>> &adjacencyList, bool *isVisited, int *level, int *minimumLevel, int *parentOf, bool *isCritical) {
     int numberOfChildren = 0;   // used to verify root has at least 2 children
 
@@ -40,52 +45,305 @@ void detectCriticalNodes(int currentNode, const vector<vector<int>> &adjacencyLi
 }
 
 
+// block-cut tree: every block (biconnected component) and every articulation
+// point is a tree node, while tree edges connect articulation points to
+// the blocks containing them; blocks are numbered from 0, and the
+// articulation points follow them
+struct BlockCutTree {
+    int numberOfBlocks, numberOfTreeNodes;
+    vector<int> blockOfEdge;    // '-1' for self-loops, which don't belong to any block
+    vector<bool> isCritical;
+    // tree node standing for every node of the graph: the articulation point
+    // itself, or the only block containing it
+    vector<int> treeNodeOf;
+
+    // rooted tree data: parent, depth, DFS entry and exit times, root of the
+    // tree containing the node (the graph may have several connected components)
+    vector<int> parentOf, depth, entryTime, exitTime, rootOf;
+    // nodes in the order of their entry times
+    vector<int> nodeAt;
+    // sparse table over the entry times of the nodes' parents, in entry time order:
+    // 'minimumParentEntryTime[k][i]' is the minimum over positions i, ..., i + 2^k - 1
+    vector<vector<int>> minimumParentEntryTime;
+};
+
+
+// iterative DFS which finds the articulation points and splits the edges into blocks;
+// 'adjacencyList' holds (adjacent node, edge index) pairs, since parallel edges matter:
+// only the tree edge itself may be skipped when looking for back edges
+void findBlocks(int numberOfNodes, const vector<vector<pair<int, int>>> &adjacencyList,
+                const vector<pair<int, int>> &edges, BlockCutTree &tree,
+                vector<pair<int, int>> &blockMembers) {
+    int numberOfEdges = (int) edges.size();
+    vector<int> level(numberOfNodes, -1), minimumLevel(numberOfNodes), parentEdgeOf(numberOfNodes, -1);
+    // the current DFS path, as (node, index of the next adjacent node to be checked) pairs
+    vector<pair<int, int>> stack;
+    // edges of the blocks which are not yet complete
+    vector<int> edgeStack;
+    // last block every node was added to, so that nodes are added to a block only once
+    vector<int> lastBlockOf(numberOfNodes, -1);
+
+    tree.numberOfBlocks = 0;
+    tree.blockOfEdge.assign(numberOfEdges, -1);
+    tree.isCritical.assign(numberOfNodes, false);
+
+    for (int root = 0; root < numberOfNodes; root++) {
+        if (level[root] != -1)
+            continue;
+
+        int numberOfChildren = 0;   // used to verify root has at least 2 children
+        level[root] = minimumLevel[root] = 0;
+        stack.emplace_back(root, 0);
+
+        while (not stack.empty()) {
+            int currentNode = stack.back().first;
+            int &nextIndex = stack.back().second;
+
+            if (nextIndex < (int) adjacencyList[currentNode].size()) {
+                int adjacentNode = adjacencyList[currentNode][nextIndex].first;
+                int edge = adjacencyList[currentNode][nextIndex].second;
+                nextIndex++;
+
+                if (edge == parentEdgeOf[currentNode])
+                    continue;
+
+                if (level[adjacentNode] == -1) {
+                    parentEdgeOf[adjacentNode] = edge;
+                    level[adjacentNode] = minimumLevel[adjacentNode] = level[currentNode] + 1;
+                    edgeStack.push_back(edge);
+                    stack.emplace_back(adjacentNode, 0);
+                }
+                // back edge to an ancestor (edges leading to descendants have already
+                // been seen from the descendant's side, and self-loops are ignored)
+                else if (level[adjacentNode] < level[currentNode]) {
+                    edgeStack.push_back(edge);
+                    minimumLevel[currentNode] = min(minimumLevel[currentNode], level[adjacentNode]);
+                }
+
+                continue;
+            }
+
+            // every adjacent node was checked, so the traversal returns to the parent node
+            stack.pop_back();
+            if (currentNode == root)
+                break;
+
+            int parentEdge = parentEdgeOf[currentNode];
+            int parent = edges[parentEdge].first ^ edges[parentEdge].second ^ currentNode;
+            minimumLevel[parent] = min(minimumLevel[parent], minimumLevel[currentNode]);
+
+            // if the lowest node reachable from the subtree of the current node
+            // is below or at its parent, then the parent separates the subtree
+            // from the rest of the graph, and the edges of the subtree (still on
+            // the edge stack) form a block together with the tree edge
+            if (minimumLevel[currentNode] >= level[parent]) {
+                int block = tree.numberOfBlocks++, edge;
+
+                do {
+                    edge = edgeStack.back();
+                    edgeStack.pop_back();
+                    tree.blockOfEdge[edge] = block;
+
+                    for (auto node: {edges[edge].first, edges[edge].second})
+                        if (lastBlockOf[node] != block) {
+                            lastBlockOf[node] = block;
+                            blockMembers.emplace_back(node, block);
+                        }
+                } while (edge != parentEdge);
+
+                if (parent != root)
+                    tree.isCritical[parent] = true;
+                else
+                    numberOfChildren++;
+            }
+        }
+
+        if (numberOfChildren > 1)
+            tree.isCritical[root] = true;
+    }
+}
+
+
+// builds the block-cut tree and prepares it for LCA queries
+void buildBlockCutTree(int numberOfNodes, const vector<vector<pair<int, int>>> &adjacencyList,
+                       const vector<pair<int, int>> &edges, BlockCutTree &tree) {
+    vector<pair<int, int>> blockMembers;
+    findBlocks(numberOfNodes, adjacencyList, edges, tree, blockMembers);
+
+    // articulation points are numbered after the blocks
+    int numberOfTreeNodes = tree.numberOfBlocks;
+    tree.treeNodeOf.assign(numberOfNodes, -1);
+    for (int node = 0; node < numberOfNodes; node++)
+        if (tree.isCritical[node])
+            tree.treeNodeOf[node] = numberOfTreeNodes++;
+
+    vector<vector<int>> treeAdjacencyList(numberOfTreeNodes);
+    for (auto &member: blockMembers) {
+        int node = member.first, block = member.second;
+
+        if (tree.isCritical[node]) {
+            treeAdjacencyList[block].push_back(tree.treeNodeOf[node]);
+            treeAdjacencyList[tree.treeNodeOf[node]].push_back(block);
+        } else
+            tree.treeNodeOf[node] = block;
+    }
+
+    // nodes without any (non-loop) edges get a block of their own
+    for (int node = 0; node < numberOfNodes; node++)
+        if (tree.treeNodeOf[node] == -1) {
+            tree.treeNodeOf[node] = numberOfTreeNodes++;
+            treeAdjacencyList.emplace_back();
+        }
+
+    tree.numberOfTreeNodes = numberOfTreeNodes;
+    tree.parentOf.assign(numberOfTreeNodes, -1);
+    tree.depth.assign(numberOfTreeNodes, 0);
+    tree.entryTime.assign(numberOfTreeNodes, -1);
+    tree.exitTime.assign(numberOfTreeNodes, -1);
+    tree.rootOf.assign(numberOfTreeNodes, -1);
+    tree.nodeAt.clear();
+
+    // iterative DFS over every tree of the forest, recording entry and exit times
+    vector<pair<int, int>> stack;
+    int time = 0;
+    for (int root = 0; root < numberOfTreeNodes; root++) {
+        if (tree.entryTime[root] != -1)
+            continue;
+
+        tree.rootOf[root] = root;
+        tree.entryTime[root] = time++;
+        tree.nodeAt.push_back(root);
+        stack.emplace_back(root, 0);
+
+        while (not stack.empty()) {
+            int node = stack.back().first;
+            int &nextIndex = stack.back().second;
+
+            if (nextIndex < (int) treeAdjacencyList[node].size()) {
+                int adjacentNode = treeAdjacencyList[node][nextIndex++];
+
+                if (tree.entryTime[adjacentNode] == -1) {
+                    tree.parentOf[adjacentNode] = node;
+                    tree.depth[adjacentNode] = tree.depth[node] + 1;
+                    tree.rootOf[adjacentNode] = root;
+                    tree.entryTime[adjacentNode] = time++;
+                    tree.nodeAt.push_back(adjacentNode);
+                    stack.emplace_back(adjacentNode, 0);
+                }
+            } else {
+                tree.exitTime[node] = time - 1;
+                stack.pop_back();
+            }
+        }
+    }
+
+    // for two different nodes a, b with entryTime[a] < entryTime[b], the parent of the
+    // shallowest node entered during (entryTime[a], entryTime[b]] is their LCA, and its
+    // entry time is the minimum entry time among the parents of those nodes
+    auto &table = tree.minimumParentEntryTime;
+    table.assign(1, vector<int>(numberOfTreeNodes));
+    for (int i = 0; i < numberOfTreeNodes; i++) {
+        int parent = tree.parentOf[tree.nodeAt[i]];
+        table[0][i] = parent == -1 ? -1 : tree.entryTime[parent];
+    }
+
+    for (int k = 1; (1 << k) <= numberOfTreeNodes; k++) {
+        table.emplace_back(numberOfTreeNodes - (1 << k) + 1);
+        for (int i = 0; i + (1 << k) <= numberOfTreeNodes; i++)
+            table[k][i] = min(table[k - 1][i], table[k - 1][i + (1 << (k - 1))]);
+    }
+}
+
+
+// O(1) - both nodes must belong to the same tree
+int lowestCommonAncestor(const BlockCutTree &tree, int firstNode, int secondNode) {
+    if (firstNode == secondNode)
+        return firstNode;
+
+    int left = tree.entryTime[firstNode], right = tree.entryTime[secondNode];
+    if (left > right)
+        swap(left, right);
+
+    // minimum over positions left + 1, ..., right
+    left++;
+    int k = 31 - __builtin_clz(right - left + 1);
+    return tree.nodeAt[min(tree.minimumParentEntryTime[k][left],
+                           tree.minimumParentEntryTime[k][right - (1 << k) + 1])];
+}
+
+
+bool isAncestor(const BlockCutTree &tree, int ancestor, int node) {
+    return tree.entryTime[ancestor] <= tree.entryTime[node] and tree.exitTime[node] <= tree.exitTime[ancestor];
+}
+
+
+// O(1) - whether 'firstNode' and 'secondNode' are still connected after 'failedNode' is removed;
+// every path between them passes through 'failedNode' exactly when it is an articulation point
+// lying on the block-cut tree path between the tree nodes standing for them
+bool remainConnected(const BlockCutTree &tree, int firstNode, int secondNode, int failedNode) {
+    if (firstNode == failedNode or secondNode == failedNode)
+        return false;
+    if (firstNode == secondNode)
+        return true;
+
+    int first = tree.treeNodeOf[firstNode], second = tree.treeNodeOf[secondNode];
+    if (tree.rootOf[first] != tree.rootOf[second])
+        return false;
+    if (not tree.isCritical[failedNode])
+        return true;
+
+    int failed = tree.treeNodeOf[failedNode];
+    int lca = lowestCommonAncestor(tree, first, second);
+
+    bool isOnPath = isAncestor(tree, lca, failed) and
+                    (isAncestor(tree, failed, first) or isAncestor(tree, failed, second));
+    return not isOnPath;
+}
+
+
 int main() {
     ifstream input("graf.in");
 
     int numberOfNodes, numberOfEdges;
     input >> numberOfNodes >> numberOfEdges;
 
-    vector<vector<int>> adjacencyList(numberOfNodes, vector<int>());
+    // (adjacent node, edge index) pairs
+    vector<vector<pair<int, int>>> adjacencyList(numberOfNodes, vector<pair<int, int>>());
+    vector<pair<int, int>> edges;
     int firstNode, secondNode;
     for (int i = 0; i < numberOfEdges; i++) {
         input >> firstNode >> secondNode;
         firstNode--;
         secondNode--;
 
-        adjacencyList[firstNode].push_back(secondNode);
-        adjacencyList[secondNode].push_back(firstNode);
+        adjacencyList[firstNode].emplace_back(secondNode, i);
+        adjacencyList[secondNode].emplace_back(firstNode, i);
+        edges.emplace_back(firstNode, secondNode);
     }
 
-    input.close();
+    BlockCutTree tree;
+    buildBlockCutTree(numberOfNodes, adjacencyList, edges, tree);
 
-    bool isVisited[numberOfNodes], isCritical[numberOfNodes];
-    int level[numberOfNodes], minimumLevel[numberOfNodes], parentOf[numberOfNodes];
+    for (int node = 0; node < numberOfNodes; node ++)
+        if (tree.isCritical[node])
+            cout << node + 1 << ' ';
+    cout << '\n';
 
-    // initialize parent and visited arrays
-    for (int i = 0; i < numberOfNodes; i++) {
-        parentOf[i] = -1;
-        isVisited[i] = false;
-        isCritical[i] = false;
+    // optional node failure queries: their number, followed by
+    // 'u v x' triplets - are u and v still connected if x fails?
+    int numberOfQueries = 0, failedNode;
+    input >> numberOfQueries;
+    for (int i = 0; i < numberOfQueries; i++) {
+        input >> firstNode >> secondNode >> failedNode;
+        cout << (remainConnected(tree, firstNode - 1, secondNode - 1, failedNode - 1) ? "YES" : "NO") << '\n';
     }
 
-    // traverse all DFS trees
-    for (int node = 0; node < numberOfNodes; node++)
-        if (not isVisited[node]) {
-            level[node] = 0;
-            minimumLevel[node] = 0;
-
-            detectCriticalNodes(node, adjacencyList, isVisited, level, minimumLevel, parentOf, isCritical);
-        }
-
-    for (int node = 0; node < numberOfNodes; node ++)
-        if (isCritical[node])
-            cout << node + 1 << ' ';
+    input.close();
 
-//    // display edges in tree
-//    for (int node = 0; node < numberOfNodes; node++)
-//        if (parentOf[node] != -1)
-//            cout << node + 1 << ' ' << parentOf[node] + 1;
+//    // display edges in block-cut tree
+//    for (int node = 0; node < tree.numberOfTreeNodes; node++)
+//        if (tree.parentOf[node] != -1)
+//            cout << node + 1 << ' ' << tree.parentOf[node] + 1 << '\n';
 
     return 0;
 
@@ -1,112 +1,215 @@
+// Cycle detection in directed graphs, given as lists of dependency pairs
+// O(n + m) per graph - iterative three-color DFS over a compressed adjacency list
+// Every call works inside a workspace (adjacency arrays, colors and the DFS stack) which keeps its
+// memory between calls, so checking a stream of small graphs stops allocating once the workspace has
+// grown to the largest of them; there is no global state, so every thread can use its own workspace.
 #include <bits/stdc++.h>
 
 using namespace std;
 
 
-int closingTheCycleNode;
+// splits [begin, end) into chunks which are handed out to the threads on demand;
+// 'function(i, threadIndex)' is called for every index, 'threadIndex' being the index of the
+// thread running it, which is useful for accessing per-thread buffers
+template<typename Function>
+void parallelFor(int begin, int end, int numberOfThreads, Function &&function) {
+    // every index is a whole (small) graph, so chunks are kept short
+    const int chunkSize = 16;
 
-void convertToAdjacencyList(vector<vector<int>> &vectorOfPairs, vector<int> *adjacencyList) {
-    for (auto pair: vectorOfPairs)
-        adjacencyList[pair[1]].push_back(pair[0]);
+    // not worth starting any threads
+    if (numberOfThreads == 1 or end - begin <= chunkSize) {
+        for (int i = begin; i < end; i++)
+            function(i, 0);
+        return;
+    }
+
+    atomic<int> nextChunk(begin);
+    auto work = [&](int threadIndex) {
+        int chunkBegin;
+        while ((chunkBegin = nextChunk.fetch_add(chunkSize)) < end)
+            for (int i = chunkBegin; i < min(end, chunkBegin + chunkSize); i++)
+                function(i, threadIndex);
+    };
+
+    vector<thread> threads;
+    for (int threadIndex = 1; threadIndex < numberOfThreads; threadIndex++)
+        threads.emplace_back(work, threadIndex);
+    work(0);
+
+    for (auto &worker: threads)
+        worker.join();
 }
 
 
-bool containsCycleDFS(int node, vector<int> *adjacencyList, bool *isVisited, bool *isInStack, vector<int> &reversedCycle) {
-    // whenever a new node is traversed,
-    // it must be marked as visited,
-    isVisited[node] = true;
-    // and marked as such
-    isInStack[node] = true;
-
-    // then, all of its adjacent nodes will also be traversed
-    for (auto adjacentNode: adjacencyList[node]) {
-        // only unvisited nodes will be traversed further.
-        // if a cycle was discovered at some point in the recursion chain, 'true' will cascade back,
-        // otherwise the loop will keep on checking the rest of the adjacent nodes, since a function
-        // call returning 'false' only means it encountered a dead end, not that there can't be any
-        // other paths leading to a cycle.
-        if (not isVisited[adjacentNode] &&
-            containsCycleDFS(adjacentNode, adjacencyList, isVisited, isInStack, reversedCycle)) {
-            // WHEN 'TRUE' CASCADES BACK, THE RECURSIVE CALL CHAIN WILL TRAVERSE
-            // THE NODES IN THE CYCLE IN THE REVERSE ORDER OF THE PATH TAKEN
-            reversedCycle.push_back(node);
-
-            return true;
-        }
+// colors of the nodes during the DFS: not visited yet, on the current path (in the stack), finished
+enum Color : char { WHITE, GRAY, BLACK };
+
+
+// memory reused by every call on the same thread ('assign' and 'clear' keep the capacity)
+struct CycleDetectionWorkspace {
+    vector<int> firstEdgeOf, adjacentNodes;
+    vector<char> colorOf;
+    // (node, next edge) pairs of the current path
+    vector<pair<int, int>> frameStack;
+};
+
+
+// every pair [a, b] means that a depends on b, which is the edge b -> a; the
+// edges are stored as a compressed adjacency list inside the workspace
+void convertToAdjacencyList(int numberOfNodes, const vector<vector<int>> &vectorOfPairs,
+                            CycleDetectionWorkspace &workspace) {
+    vector<int> &firstEdgeOf = workspace.firstEdgeOf;
+    firstEdgeOf.assign(numberOfNodes + 1, 0);
+    workspace.adjacentNodes.resize(vectorOfPairs.size());
+
+    // 'firstEdgeOf[node]' first counts the edges leaving the nodes up to 'node', which is where its list
+    // ends; the edges are then placed back to front, which leaves it pointing at the start of the list,
+    // without any extra array of positions
+    for (auto &pair: vectorOfPairs)
+        firstEdgeOf[pair[1]]++;
+    for (int node = 0; node < numberOfNodes; node++)
+        firstEdgeOf[node + 1] += firstEdgeOf[node];
+
+    for (int i = (int) vectorOfPairs.size() - 1; i >= 0; i--)
+        workspace.adjacentNodes[--firstEdgeOf[vectorOfPairs[i][1]]] = vectorOfPairs[i][0];
+}
+
+
+// returns whether the graph contains a cycle; if it does, 'cycle' receives one, as the closed walk
+// [closing node, ..., closing node], the closing node being the first node found twice on the path
+bool findCycle(int numberOfNodes, const vector<vector<int>> &vectorOfPairs, CycleDetectionWorkspace &workspace,
+               vector<int> &cycle) {
+    cycle.clear();
+    convertToAdjacencyList(numberOfNodes, vectorOfPairs, workspace);
 
-            // if the node is visited and also in the stack, it must be the node which 'completes' or
-            // 'closes' the cycle, otherwise it is part of an already visited acyclic DFS tree
-        else if (isInStack[adjacentNode]) {
-            // THIS IS WHERE THE NODE COMPLETING THE CYCLE IS ENCOUNTERED
-            reversedCycle.push_back(adjacentNode);
-            // pushing the node that led to it
-            reversedCycle.push_back(node);
-            closingTheCycleNode = adjacentNode;
+    const vector<int> &firstEdgeOf = workspace.firstEdgeOf, &adjacentNodes = workspace.adjacentNodes;
+    vector<char> &colorOf = workspace.colorOf;
+    vector<pair<int, int>> &frameStack = workspace.frameStack;
 
-            return true;
+    colorOf.assign(numberOfNodes, WHITE);
+    frameStack.clear();
+
+    // traversing all nodes, to analyse all DFS trees
+    for (int sourceNode = 0; sourceNode < numberOfNodes; sourceNode++) {
+        if (colorOf[sourceNode] != WHITE)
+            continue;
+
+        colorOf[sourceNode] = GRAY;
+        frameStack.emplace_back(sourceNode, firstEdgeOf[sourceNode]);
+
+        while (not frameStack.empty()) {
+            int node = frameStack.back().first;
+
+            // every adjacent node has been explored, so the node leaves the path
+            if (frameStack.back().second == firstEdgeOf[node + 1]) {
+                colorOf[node] = BLACK;
+                frameStack.pop_back();
+                continue;
+            }
+
+            int adjacentNode = adjacentNodes[frameStack.back().second++];
+
+            if (colorOf[adjacentNode] == WHITE) {
+                colorOf[adjacentNode] = GRAY;
+                frameStack.emplace_back(adjacentNode, firstEdgeOf[adjacentNode]);
+            } else if (colorOf[adjacentNode] == GRAY) {
+                // the adjacent node is on the current path, so it closes the cycle:
+                // the cycle is the part of the path starting at it
+                int frame = (int) frameStack.size() - 1;
+                while (frameStack[frame].first != adjacentNode)
+                    frame--;
+
+                for (; frame < (int) frameStack.size(); frame++)
+                    cycle.push_back(frameStack[frame].first);
+                cycle.push_back(adjacentNode);
+
+                return true;
+            }
+            // black nodes belong to already finished, acyclic parts of the graph
         }
     }
 
-    // unmarking 'dead-end' paths
-    isInStack[node] = false;
+    // no cycles were found in any of the DFS trees
     return false;
 }
 
 
-// wrapper function used for traversing all DFS trees
+// wrapper which keeps a workspace per thread; returns the cycle (empty if there is none)
 vector<int> containsCycle(int numberOfNodes, vector<vector<int>> &adjacencyList) {
-    // storing edges in a more convenient way (array of vectors)
-    vector<int> adjacencyListModified[numberOfNodes];
-    convertToAdjacencyList(adjacencyList, adjacencyListModified);
+    thread_local CycleDetectionWorkspace workspace;
 
-    bool isVisited[numberOfNodes]; // necessary to mark visited nodes
-    bool isInStack[numberOfNodes]; // for checking if a node is in the stack
+    vector<int> cycle;
+    findCycle(numberOfNodes, adjacencyList, workspace, cycle);
+    return cycle;
+}
 
-    for (int i = 0; i < numberOfNodes; i++) {
-        isVisited[i] = false;
-        isInStack[i] = false;
-    }
 
-    vector<int> reversedCycle;  // vector which will be returned
-    // traversing all nodes, to analyse all DFS trees
-    for (int i = 0; i < numberOfNodes; i++)
-        // visited nodes are part of a traversed DFS tree, therefore only unvisited nodes will be considered;
-        // acyclic DFS trees will be ignored and the loop will proceed in checking the remaining trees
-        if (not isVisited[i] && containsCycleDFS(i, adjacencyListModified, isVisited, isInStack, reversedCycle)) {
-            // for every DFS tree, the stack begins as empty and is continuously
-            // popped from and pushed to during the traversal;
-            // whenever a new node is visited, it is pushed to the stack along with each of its
-            // adjacent nodes, recursively searching for a possible path which ends in a cycle.
-            // all encountered 'dead-end' paths are then discarded, back to the first node which
-            // still has possible paths to take (unvisited adjacent nodes);
-            // since the function exits when a cycle is detected, it is guaranteed that the stack
-            // only contains the uninterrupted path that leaded back to one of the nodes in the path.
-            // the stack might also contain nodes which leaded to the detected cycle, but of which
-            // they aren't a part of, which is where 'closingTheCycleNode' helps.
-            // when a node already in the stack is encountered, it is stored in said variable, since
-            // it completes the cycle.
-            // upon returning, the vector is traversed and the first elements which are not equal to
-            // the completing node will be discarded
-            int j;
-            for (j = 0; j < reversedCycle.size() && reversedCycle[j] != closingTheCycleNode; j++);
-
-            vector<int> cycle;
-            for (; j < reversedCycle.size(); j++)
-                cycle.push_back(reversedCycle[j]);
-
-            // since the nodes popped from the stack are in the reverse order of traversal, the vector
-            // must be reversed in order to find the correct cycle direction;
-            reverse(cycle.begin(), cycle.end());
-
-            return cycle;
-        }
+struct DependencyGraph {
+    int numberOfNodes;
+    vector<vector<int>> vectorOfPairs;
+};
 
-    // no cycles were found in any of the DFS trees
-    return {};
+
+// checks every graph of the batch, splitting them among the threads (each with its own
+// workspace); returns the cycle found in every graph (empty for acyclic graphs)
+vector<vector<int>> findCyclesInParallel(const vector<DependencyGraph> &graphs, int numberOfThreads) {
+    vector<vector<int>> cycles(graphs.size());
+    vector<CycleDetectionWorkspace> workspaces(numberOfThreads);
+
+    parallelFor(0, (int) graphs.size(), numberOfThreads, [&](int i, int threadIndex) {
+        findCycle(graphs[i].numberOfNodes, graphs[i].vectorOfPairs, workspaces[threadIndex], cycles[i]);
+    });
+
+    return cycles;
 }
 
 
-int main() {
+// the number of threads may be given as the first argument (all cores by default)
+int main(int argc, char **argv) {
+    int numberOfThreads = argc > 1 ? atoi(argv[1]) : (int) thread::hardware_concurrency();
+    numberOfThreads = max(numberOfThreads, 1);
+
+    // the number of graphs, followed by every graph: its number of nodes and pairs,
+    // then the pairs 'a b', meaning that a depends on b
+    ifstream input("cycle.in");
+
+    int numberOfGraphs;
+    input >> numberOfGraphs;
+
+    vector<DependencyGraph> graphs(numberOfGraphs);
+    for (auto &graph: graphs) {
+        int numberOfPairs;
+        input >> graph.numberOfNodes >> numberOfPairs;
+
+        graph.vectorOfPairs.assign(numberOfPairs, vector<int>(2));
+        for (auto &pair: graph.vectorOfPairs) {
+            input >> pair[0] >> pair[1];
+            pair[0]--;
+            pair[1]--;
+        }
+    }
+
+    input.close();
+
+    auto start = chrono::steady_clock::now();
+    vector<vector<int>> cycles = findCyclesInParallel(graphs, numberOfThreads);
+    auto finish = chrono::steady_clock::now();
+
+    cerr << numberOfGraphs << " graphs, " << numberOfThreads << " threads: "
+         << chrono::duration_cast<chrono::milliseconds>(finish - start).count() << " ms\n";
+
+    ofstream output("cycle.out");
+
+    // for every graph, the number of nodes on its cycle ('0' if it has none),
+    // followed by the cycle, starting and ending at the node which closes it
+    for (auto &cycle: cycles) {
+        output << (cycle.empty() ? 0 : (int) cycle.size() - 1);
+        for (auto node: cycle)
+            output << ' ' << node + 1;
+        output << '\n';
+    }
+
+    output.close();
 
     return 0;
 }
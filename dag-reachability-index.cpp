@@ -0,0 +1,401 @@
+// Reachability index for DAGs: "can u reach v?" answered mostly in O(1), without traversing the graph
+// Building it takes O(k*(n + m)) time and O(k*n) space, k being the number of random DFS traversals:
+// - topological order and levels (Kahn's algorithm): u can only reach v if it comes earlier in the
+// order and sits on a lower level (the length of the longest path leading to a node)
+// - interval labels (GRAIL): every DFS traversal labels a node with the interval of post-order
+// ranks spanned by its descendants; if v is reachable from u, its interval lies inside u's one in
+// every traversal, so a single traversal where it doesn't proves that u can't reach v
+// - landmarks (bit-parallel partial transitive closure): for the 64 nodes of the highest degrees,
+// every node keeps a bitmask of the landmarks it can reach and another of those which can reach
+// it; u reaching a landmark which reaches v proves reachability, while a landmark reaching u but
+// not v (or reached by v but not by u) proves the opposite
+// Queries which none of the cuts settle fall back on a DFS from u, which is pruned by the same cuts.
+#include <bits/stdc++.h>
+
+using namespace std;
+
+
+// buffered reader for large inputs: the file is read in blocks of 64KB,
+// instead of parsing one token at a time through 'ifstream'
+struct InputReader {
+    FILE *file;
+    char buffer[1 << 16];
+    int size = 0, position = 0;
+
+    explicit InputReader(const char *fileName) : file(fopen(fileName, "r")) {}
+
+    ~InputReader() {
+        if (file)
+            fclose(file);
+    }
+
+    int nextCharacter() {
+        if (position == size) {
+            size = (int) fread(buffer, 1, sizeof(buffer), file);
+            position = 0;
+            if (size <= 0)
+                return EOF;
+        }
+        return (unsigned char) buffer[position++];
+    }
+
+    // returns false once the end of the file is reached
+    bool readInt(int &value) {
+        int character = nextCharacter();
+        while (character != EOF and character != '-' and not isdigit(character))
+            character = nextCharacter();
+        if (character == EOF)
+            return false;
+
+        bool isNegative = character == '-';
+        if (isNegative)
+            character = nextCharacter();
+
+        value = 0;
+        for (; character != EOF and isdigit(character); character = nextCharacter())
+            value = value * 10 + (character - '0');
+        if (isNegative)
+            value = -value;
+
+        return true;
+    }
+};
+
+
+// compressed adjacency list: the adjacent nodes of 'node' are
+// 'adjacentNodes[firstEdgeOf[node]]', ..., 'adjacentNodes[firstEdgeOf[node + 1] - 1]'
+void buildCompressedAdjacencyList(int numberOfNodes, const vector<int> &outNodes, const vector<int> &inNodes,
+                                  vector<int> &firstEdgeOf, vector<int> &adjacentNodes) {
+    firstEdgeOf.assign(numberOfNodes + 1, 0);
+    adjacentNodes.resize(outNodes.size());
+
+    for (auto node: outNodes)
+        firstEdgeOf[node + 1]++;
+    for (int node = 0; node < numberOfNodes; node++)
+        firstEdgeOf[node + 1] += firstEdgeOf[node];
+
+    vector<int> nextPosition(firstEdgeOf.begin(), firstEdgeOf.end() - 1);
+    for (int edge = 0; edge < (int) outNodes.size(); edge++)
+        adjacentNodes[nextPosition[outNodes[edge]]++] = inNodes[edge];
+}
+
+
+const int NUMBER_OF_LANDMARKS = 64;
+
+
+struct ReachabilityIndex {
+    int numberOfNodes, numberOfTraversals;
+    const vector<int> *firstOutEdgeOf, *outNodes;
+    vector<int> topologicalOrder, positionOf, levelOf;
+    // the interval of every node in every traversal, grouped by node so that a query touches
+    // only two cache lines: '[lowestRankOf[node * k + i], rankOf[node * k + i]]' for traversal i
+    vector<int> lowestRankOf, rankOf;
+    // bit i is set if the node reaches landmark i (or is reached by it)
+    vector<uint64_t> reachesLandmarks, reachedByLandmarks;
+};
+
+
+// workspace of the fallback searches, reused by every query of a thread
+struct ReachabilityQueryWorkspace {
+    vector<int> visitedBy, stack;
+    int currentQuery = 0;
+};
+
+
+// returns false if the graph has cycles
+bool computeTopologicalOrder(ReachabilityIndex &index) {
+    int numberOfNodes = index.numberOfNodes;
+    const vector<int> &firstEdgeOf = *index.firstOutEdgeOf, &adjacentNodes = *index.outNodes;
+
+    vector<int> inDegrees(numberOfNodes, 0);
+    for (auto node: adjacentNodes)
+        inDegrees[node]++;
+
+    index.topologicalOrder.clear();
+    index.topologicalOrder.reserve(numberOfNodes);
+    index.levelOf.assign(numberOfNodes, 0);
+
+    for (int node = 0; node < numberOfNodes; node++)
+        if (inDegrees[node] == 0)
+            index.topologicalOrder.push_back(node);
+
+    for (int i = 0; i < (int) index.topologicalOrder.size(); i++) {
+        int node = index.topologicalOrder[i];
+        for (int edge = firstEdgeOf[node]; edge < firstEdgeOf[node + 1]; edge++) {
+            int adjacentNode = adjacentNodes[edge];
+            index.levelOf[adjacentNode] = max(index.levelOf[adjacentNode], index.levelOf[node] + 1);
+            if (--inDegrees[adjacentNode] == 0)
+                index.topologicalOrder.push_back(adjacentNode);
+        }
+    }
+
+    if ((int) index.topologicalOrder.size() < numberOfNodes)
+        return false;
+
+    index.positionOf.resize(numberOfNodes);
+    for (int position = 0; position < numberOfNodes; position++)
+        index.positionOf[index.topologicalOrder[position]] = position;
+
+    return true;
+}
+
+
+// one randomized DFS traversal: the roots are visited in random order, and the edges of every
+// node are scanned starting at a random offset, so that the traversals differ from each other
+void labelIntervals(ReachabilityIndex &index, int traversal, mt19937 &generator) {
+    int numberOfNodes = index.numberOfNodes, k = index.numberOfTraversals;
+    const vector<int> &firstEdgeOf = *index.firstOutEdgeOf, &adjacentNodes = *index.outNodes;
+
+    vector<int> roots;
+    for (int node = 0; node < numberOfNodes; node++)
+        if (index.levelOf[node] == 0)
+            roots.push_back(node);
+    shuffle(roots.begin(), roots.end(), generator);
+
+    // (node, number of scanned edges) pairs; the first edge scanned is 'startEdgeOf[node]'
+    vector<pair<int, int>> stack;
+    vector<int> startEdgeOf(numberOfNodes);
+    vector<char> isVisited(numberOfNodes, false);
+    int nextRank = 0;
+
+    for (auto root: roots) {
+        isVisited[root] = true;
+        stack.emplace_back(root, 0);
+
+        while (not stack.empty()) {
+            int node = stack.back().first;
+            int degree = firstEdgeOf[node + 1] - firstEdgeOf[node];
+
+            if (stack.back().second == 0 and degree > 0)
+                startEdgeOf[node] = (int) (generator() % degree);
+
+            if (stack.back().second < degree) {
+                int adjacentNode = adjacentNodes[firstEdgeOf[node] +
+                                                 (startEdgeOf[node] + stack.back().second++) % degree];
+                if (not isVisited[adjacentNode]) {
+                    isVisited[adjacentNode] = true;
+                    stack.emplace_back(adjacentNode, 0);
+                }
+                continue;
+            }
+
+            stack.pop_back();
+
+            // the interval spans the lowest rank among all of the node's children, not only
+            // those discovered through it, since every descendant has to fit inside it
+            int lowestRank = nextRank;
+            for (int edge = firstEdgeOf[node]; edge < firstEdgeOf[node + 1]; edge++)
+                lowestRank = min(lowestRank, index.lowestRankOf[(size_t) adjacentNodes[edge] * k + traversal]);
+
+            index.rankOf[(size_t) node * k + traversal] = nextRank++;
+            index.lowestRankOf[(size_t) node * k + traversal] = lowestRank;
+        }
+    }
+}
+
+
+// the landmarks are the nodes with the largest (in-degree + 1) * (out-degree + 1), as those lie on the most paths
+void labelLandmarks(ReachabilityIndex &index, const vector<int> &firstInEdgeOf) {
+    int numberOfNodes = index.numberOfNodes;
+    const vector<int> &firstEdgeOf = *index.firstOutEdgeOf, &adjacentNodes = *index.outNodes;
+
+    vector<int> landmarks(numberOfNodes);
+    iota(landmarks.begin(), landmarks.end(), 0);
+
+    auto score = [&](int node) {
+        return (long long) (firstEdgeOf[node + 1] - firstEdgeOf[node] + 1) *
+               (firstInEdgeOf[node + 1] - firstInEdgeOf[node] + 1);
+    };
+    int numberOfLandmarks = min(NUMBER_OF_LANDMARKS, numberOfNodes);
+    partial_sort(landmarks.begin(), landmarks.begin() + numberOfLandmarks, landmarks.end(),
+                 [&](int first, int second) { return score(first) > score(second); });
+
+    index.reachesLandmarks.assign(numberOfNodes, 0);
+    index.reachedByLandmarks.assign(numberOfNodes, 0);
+    for (int i = 0; i < numberOfLandmarks; i++)
+        index.reachesLandmarks[landmarks[i]] = index.reachedByLandmarks[landmarks[i]] = 1ULL << i;
+
+    // both bitmasks are unions over the neighbors, propagated along the topological order
+    for (int position = 0; position < numberOfNodes; position++) {
+        int node = index.topologicalOrder[position];
+        for (int edge = firstEdgeOf[node]; edge < firstEdgeOf[node + 1]; edge++)
+            index.reachedByLandmarks[adjacentNodes[edge]] |= index.reachedByLandmarks[node];
+    }
+
+    for (int position = numberOfNodes - 1; position >= 0; position--) {
+        int node = index.topologicalOrder[position];
+        for (int edge = firstEdgeOf[node]; edge < firstEdgeOf[node + 1]; edge++)
+            index.reachesLandmarks[node] |= index.reachesLandmarks[adjacentNodes[edge]];
+    }
+}
+
+
+// returns false if the graph has cycles (in which case the index can't be used)
+bool buildReachabilityIndex(ReachabilityIndex &index, int numberOfNodes, int numberOfTraversals,
+                            const vector<int> &firstOutEdgeOf, const vector<int> &outNodes,
+                            const vector<int> &firstInEdgeOf) {
+    index.numberOfNodes = numberOfNodes;
+    index.numberOfTraversals = numberOfTraversals;
+    index.firstOutEdgeOf = &firstOutEdgeOf;
+    index.outNodes = &outNodes;
+
+    if (not computeTopologicalOrder(index))
+        return false;
+
+    index.lowestRankOf.resize((size_t) numberOfNodes * numberOfTraversals);
+    index.rankOf.resize((size_t) numberOfNodes * numberOfTraversals);
+
+    mt19937 generator(2024);
+    for (int traversal = 0; traversal < numberOfTraversals; traversal++)
+        labelIntervals(index, traversal, generator);
+
+    labelLandmarks(index, firstInEdgeOf);
+
+    return true;
+}
+
+
+// '1' if the index proves that 'node' reaches 'target', '0' if it proves the opposite, '-1' if neither
+int checkCuts(const ReachabilityIndex &index, int node, int target) {
+    if (node == target)
+        return 1;
+
+    if (index.positionOf[node] > index.positionOf[target] or index.levelOf[node] >= index.levelOf[target])
+        return 0;
+
+    if (index.reachesLandmarks[node] & index.reachedByLandmarks[target])
+        return 1;
+    if ((index.reachedByLandmarks[node] & ~index.reachedByLandmarks[target]) or
+        (index.reachesLandmarks[target] & ~index.reachesLandmarks[node]))
+        return 0;
+
+    int k = index.numberOfTraversals;
+    const int *nodeLowest = &index.lowestRankOf[(size_t) node * k], *nodeRank = &index.rankOf[(size_t) node * k];
+    const int *targetLowest = &index.lowestRankOf[(size_t) target * k], *targetRank = &index.rankOf[(size_t) target * k];
+    for (int traversal = 0; traversal < k; traversal++)
+        if (targetLowest[traversal] < nodeLowest[traversal] or targetRank[traversal] > nodeRank[traversal])
+            return 0;
+
+    return -1;
+}
+
+
+bool canReach(const ReachabilityIndex &index, ReachabilityQueryWorkspace &workspace, int sourceNode, int target) {
+    int verdict = checkCuts(index, sourceNode, target);
+    if (verdict != -1)
+        return verdict == 1;
+
+    // pruned DFS: nodes which the cuts prove unable to reach the target are never entered
+    const vector<int> &firstEdgeOf = *index.firstOutEdgeOf, &adjacentNodes = *index.outNodes;
+    if (workspace.visitedBy.empty())
+        workspace.visitedBy.assign(index.numberOfNodes, 0);
+    int query = ++workspace.currentQuery;
+
+    workspace.stack.assign(1, sourceNode);
+    workspace.visitedBy[sourceNode] = query;
+
+    while (not workspace.stack.empty()) {
+        int node = workspace.stack.back();
+        workspace.stack.pop_back();
+
+        for (int edge = firstEdgeOf[node]; edge < firstEdgeOf[node + 1]; edge++) {
+            int adjacentNode = adjacentNodes[edge];
+            if (workspace.visitedBy[adjacentNode] == query)
+                continue;
+            workspace.visitedBy[adjacentNode] = query;
+
+            verdict = checkCuts(index, adjacentNode, target);
+            if (verdict == 1)
+                return true;
+            if (verdict == -1)
+                workspace.stack.push_back(adjacentNode);
+        }
+    }
+
+    return false;
+}
+
+
+// the number of DFS traversals may be given as the first argument (5 by default)
+int main(int argc, char **argv) {
+    int numberOfTraversals = argc > 1 ? max(atoi(argv[1]), 1) : 5;
+
+    // number of nodes and edges, followed by the edges, the number of queries and the queries
+    InputReader input("reach.in");
+    if (not input.file) {
+        cerr << "can't open reach.in\n";
+        return 1;
+    }
+
+    int numberOfNodes = 0, numberOfEdges = 0;
+    input.readInt(numberOfNodes);
+    input.readInt(numberOfEdges);
+
+    vector<int> outNodes(numberOfEdges), inNodes(numberOfEdges);
+    for (int i = 0; i < numberOfEdges; i++) {
+        input.readInt(outNodes[i]);
+        input.readInt(inNodes[i]);
+        outNodes[i]--;
+        inNodes[i]--;
+    }
+
+    int numberOfQueries = 0;
+    input.readInt(numberOfQueries);
+    vector<pair<int, int>> queries(numberOfQueries);
+    for (auto &query: queries) {
+        input.readInt(query.first);
+        input.readInt(query.second);
+        query.first--;
+        query.second--;
+    }
+
+    vector<int> firstOutEdgeOf, adjacentOutNodes, firstInEdgeOf, adjacentInNodes;
+    buildCompressedAdjacencyList(numberOfNodes, outNodes, inNodes, firstOutEdgeOf, adjacentOutNodes);
+    buildCompressedAdjacencyList(numberOfNodes, inNodes, outNodes, firstInEdgeOf, adjacentInNodes);
+
+    vector<int>().swap(outNodes);
+    vector<int>().swap(inNodes);
+
+    ofstream output;
+    output.open("reach.out");
+
+    auto start = chrono::steady_clock::now();
+    ReachabilityIndex index;
+    if (not buildReachabilityIndex(index, numberOfNodes, numberOfTraversals, firstOutEdgeOf, adjacentOutNodes,
+                                   firstInEdgeOf)) {
+        output << -1 << '\n';
+        output.close();
+        return 0;
+    }
+    auto finish = chrono::steady_clock::now();
+
+    size_t indexSize = (index.topologicalOrder.size() + index.positionOf.size() + index.levelOf.size() +
+                        index.lowestRankOf.size() + index.rankOf.size()) * sizeof(int) +
+                       (index.reachesLandmarks.size() + index.reachedByLandmarks.size()) * sizeof(uint64_t);
+    cerr << "index: " << indexSize / 1024 << " KB, built in "
+         << chrono::duration_cast<chrono::milliseconds>(finish - start).count() << " ms\n";
+
+    ReachabilityQueryWorkspace workspace;
+    vector<char> answers(numberOfQueries);
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < numberOfQueries; i++)
+        answers[i] = canReach(index, workspace, queries[i].first, queries[i].second);
+    finish = chrono::steady_clock::now();
+
+    int settledByCuts = 0;
+    for (auto &query: queries)
+        settledByCuts += checkCuts(index, query.first, query.second) != -1;
+
+    if (numberOfQueries > 0)
+        cerr << numberOfQueries << " queries, " << settledByCuts << " settled without searching, "
+             << chrono::duration_cast<chrono::nanoseconds>(finish - start).count() / numberOfQueries
+             << " ns per query\n";
+
+    for (auto answer: answers)
+        output << (answer ? "YES" : "NO") << '\n';
+
+    output.close();
+
+    return 0;
+}
@@ -0,0 +1,264 @@
+// DAG task executor, built on the in-degree counting of Kahn's algorithm (see topological-sorting.cpp)
+// O(n + m) scheduling work, spread over a pool of threads:
+// - every node is a task, which becomes ready once all of its predecessors have run; in-degrees are
+// atomic, so the thread finishing the last predecessor of a node is the one which releases it
+// - every thread owns a deque of ready tasks: it pushes and pops tasks at the back, while idle
+// threads steal the oldest tasks from the front of the other deques
+// - tasks are prioritized by their bottom level (the number of tasks on the longest path starting
+// at them), so the critical path is never left waiting; out of the tasks released by a finished
+// task, the most critical one runs next on the same thread, without passing through any deque
+#include <bits/stdc++.h>
+
+using namespace std;
+
+
+// compressed adjacency list: the adjacent nodes of 'node' are
+// 'adjacentNodes[firstEdgeOf[node]]', ..., 'adjacentNodes[firstEdgeOf[node + 1] - 1]'
+void buildCompressedAdjacencyList(int numberOfNodes, const vector<int> &outNodes, const vector<int> &inNodes,
+                                  vector<int> &firstEdgeOf, vector<int> &adjacentNodes) {
+    firstEdgeOf.assign(numberOfNodes + 1, 0);
+    adjacentNodes.resize(outNodes.size());
+
+    for (auto node: outNodes)
+        firstEdgeOf[node + 1]++;
+    for (int node = 0; node < numberOfNodes; node++)
+        firstEdgeOf[node + 1] += firstEdgeOf[node];
+
+    vector<int> nextPosition(firstEdgeOf.begin(), firstEdgeOf.end() - 1);
+    for (int edge = 0; edge < (int) outNodes.size(); edge++)
+        adjacentNodes[nextPosition[outNodes[edge]]++] = inNodes[edge];
+}
+
+
+// O(n + m) - bottom level of every node, through Kahn's algorithm run backwards over the order it
+// produces; nodes which lie on a cycle or can be reached from one never run, and are left at 0
+vector<int> computeBottomLevels(int numberOfNodes, const vector<int> &firstEdgeOf, const vector<int> &adjacentNodes) {
+    vector<int> inDegrees(numberOfNodes, 0), order;
+    order.reserve(numberOfNodes);
+
+    for (auto node: adjacentNodes)
+        inDegrees[node]++;
+    for (int node = 0; node < numberOfNodes; node++)
+        if (inDegrees[node] == 0)
+            order.push_back(node);
+
+    for (int i = 0; i < (int) order.size(); i++)
+        for (int edge = firstEdgeOf[order[i]]; edge < firstEdgeOf[order[i] + 1]; edge++)
+            if (--inDegrees[adjacentNodes[edge]] == 0)
+                order.push_back(adjacentNodes[edge]);
+
+    vector<int> bottomLevelOf(numberOfNodes, 0);
+    for (int i = (int) order.size() - 1; i >= 0; i--) {
+        int node = order[i];
+        bottomLevelOf[node] = 1;
+        for (int edge = firstEdgeOf[node]; edge < firstEdgeOf[node + 1]; edge++)
+            bottomLevelOf[node] = max(bottomLevelOf[node], bottomLevelOf[adjacentNodes[edge]] + 1);
+    }
+
+    return bottomLevelOf;
+}
+
+
+// deque of ready tasks owned by one thread; every deque is placed on its own cache line,
+// so that threads working on their own deques don't slow each other down
+struct alignas(64) WorkStealingDeque {
+    mutex lock;
+    deque<int> tasks;
+};
+
+
+struct ExecutionStatistics {
+    int executedTasks = 0;
+    long long stolenTasks = 0;
+};
+
+
+// runs 'task(node, threadIndex)' for every node of the graph, once all of its predecessors have run;
+// writes made by a task are visible to the tasks depending on it; tasks which are blocked by cycles never run
+template<typename Task>
+ExecutionStatistics executeDAG(int numberOfNodes, int numberOfThreads, const vector<int> &firstEdgeOf,
+                               const vector<int> &adjacentNodes, Task &&task) {
+    vector<int> bottomLevelOf = computeBottomLevels(numberOfNodes, firstEdgeOf, adjacentNodes);
+
+    ExecutionStatistics statistics;
+    for (int node = 0; node < numberOfNodes; node++)
+        statistics.executedTasks += bottomLevelOf[node] > 0;
+
+    vector<atomic<int>> inDegrees(numberOfNodes);
+    for (int node = 0; node < numberOfNodes; node++)
+        inDegrees[node].store(0, memory_order_relaxed);
+    for (auto node: adjacentNodes)
+        inDegrees[node].fetch_add(1, memory_order_relaxed);
+
+    // tasks which haven't finished yet; the threads stop once it drops to zero
+    atomic<int> remainingTasks(statistics.executedTasks);
+    atomic<long long> stolenTasks(0);
+
+    auto byPriority = [&](int first, int second) { return bottomLevelOf[first] < bottomLevelOf[second]; };
+
+    // the initial tasks are dealt out in increasing order of priority,
+    // so that every deque holds its most critical tasks at the back
+    vector<int> sources;
+    for (int node = 0; node < numberOfNodes; node++)
+        if (inDegrees[node].load(memory_order_relaxed) == 0)
+            sources.push_back(node);
+    sort(sources.begin(), sources.end(), byPriority);
+
+    vector<WorkStealingDeque> deques(numberOfThreads);
+    for (int i = 0; i < (int) sources.size(); i++)
+        deques[i % numberOfThreads].tasks.push_back(sources[i]);
+
+    auto popOwnTask = [&](int threadIndex) {
+        WorkStealingDeque &own = deques[threadIndex];
+        lock_guard<mutex> guard(own.lock);
+        if (own.tasks.empty())
+            return -1;
+
+        int node = own.tasks.back();
+        own.tasks.pop_back();
+        return node;
+    };
+
+    auto stealTask = [&](int threadIndex, mt19937 &generator) {
+        int firstVictim = (int) (generator() % numberOfThreads);
+
+        for (int i = 0; i < numberOfThreads; i++) {
+            int victim = (firstVictim + i) % numberOfThreads;
+            if (victim == threadIndex)
+                continue;
+
+            WorkStealingDeque &victimDeque = deques[victim];
+            lock_guard<mutex> guard(victimDeque.lock);
+            if (not victimDeque.tasks.empty()) {
+                int node = victimDeque.tasks.front();
+                victimDeque.tasks.pop_front();
+                return node;
+            }
+        }
+
+        return -1;
+    };
+
+    auto work = [&](int threadIndex) {
+        mt19937 generator(threadIndex + 1);
+        vector<int> releasedTasks;
+        long long stolenByThread = 0;
+        int node = -1;
+
+        while (remainingTasks.load(memory_order_acquire) > 0) {
+            if (node == -1)
+                node = popOwnTask(threadIndex);
+            if (node == -1 and numberOfThreads > 1) {
+                node = stealTask(threadIndex, generator);
+                stolenByThread += node != -1;
+            }
+            if (node == -1) {
+                this_thread::yield();
+                continue;
+            }
+
+            task(node, threadIndex);
+
+            // the thread which drops the in-degree of a successor to zero releases it; the
+            // acquire-release decrements make the writes of every predecessor visible to it
+            releasedTasks.clear();
+            for (int edge = firstEdgeOf[node]; edge < firstEdgeOf[node + 1]; edge++)
+                if (inDegrees[adjacentNodes[edge]].fetch_sub(1, memory_order_acq_rel) == 1)
+                    releasedTasks.push_back(adjacentNodes[edge]);
+
+            node = -1;
+            if (not releasedTasks.empty()) {
+                // the most critical released task runs right away, and the others are
+                // pushed in increasing order of priority, so the next most critical is on top
+                sort(releasedTasks.begin(), releasedTasks.end(), byPriority);
+                node = releasedTasks.back();
+                releasedTasks.pop_back();
+
+                if (not releasedTasks.empty()) {
+                    WorkStealingDeque &own = deques[threadIndex];
+                    lock_guard<mutex> guard(own.lock);
+                    own.tasks.insert(own.tasks.end(), releasedTasks.begin(), releasedTasks.end());
+                }
+            }
+
+            remainingTasks.fetch_sub(1, memory_order_release);
+        }
+
+        stolenTasks.fetch_add(stolenByThread, memory_order_relaxed);
+    };
+
+    vector<thread> threads;
+    for (int threadIndex = 1; threadIndex < numberOfThreads; threadIndex++)
+        threads.emplace_back(work, threadIndex);
+    work(0);
+
+    for (auto &worker: threads)
+        worker.join();
+
+    statistics.stolenTasks = stolenTasks.load();
+    return statistics;
+}
+
+
+// the number of threads may be given as the first argument (all cores by default)
+int main(int argc, char **argv) {
+    int numberOfThreads = argc > 1 ? atoi(argv[1]) : (int) thread::hardware_concurrency();
+    numberOfThreads = max(numberOfThreads, 1);
+
+    int numberOfNodes, numberOfEdges;
+    ifstream input;
+
+    // number of tasks and dependencies, followed by the dependencies,
+    // as edges from every task to a task which has to wait for it
+    input.open("tasks.in");
+
+    input >> numberOfNodes >> numberOfEdges;
+    vector<int> outNodes(numberOfEdges), inNodes(numberOfEdges);
+
+    for (int i = 0; i < numberOfEdges; i++) {
+        input >> outNodes[i] >> inNodes[i];
+        outNodes[i]--;
+        inNodes[i]--;
+    }
+
+    input.close();
+
+    vector<int> firstOutEdgeOf, adjacentOutNodes, firstInEdgeOf, adjacentInNodes;
+    buildCompressedAdjacencyList(numberOfNodes, outNodes, inNodes, firstOutEdgeOf, adjacentOutNodes);
+    buildCompressedAdjacencyList(numberOfNodes, inNodes, outNodes, firstInEdgeOf, adjacentInNodes);
+
+    vector<int>().swap(outNodes);
+    vector<int>().swap(inNodes);
+
+    // a tiny task: the step at which every task could run at the earliest, which only
+    // depends on the steps of its predecessors ('0' for tasks which never ran)
+    vector<int> earliestStepOf(numberOfNodes, 0);
+
+    auto start = chrono::steady_clock::now();
+    ExecutionStatistics statistics = executeDAG(
+            numberOfNodes, numberOfThreads, firstOutEdgeOf, adjacentOutNodes, [&](int node, int /*threadIndex*/) {
+                int step = 1;
+                for (int edge = firstInEdgeOf[node]; edge < firstInEdgeOf[node + 1]; edge++)
+                    step = max(step, earliestStepOf[adjacentInNodes[edge]] + 1);
+                earliestStepOf[node] = step;
+            });
+    auto finish = chrono::steady_clock::now();
+
+    double seconds = chrono::duration<double>(finish - start).count();
+    cerr << numberOfThreads << " threads: " << (long long) (seconds * 1000) << " ms, "
+         << (long long) (statistics.executedTasks / max(seconds, 1e-9)) << " tasks/s, "
+         << statistics.stolenTasks << " stolen\n";
+
+    ofstream output;
+    output.open("tasks.out");
+
+    // the number of tasks which ran, followed by the earliest step of every task
+    output << statistics.executedTasks << '\n';
+    for (int node = 0; node < numberOfNodes; node++)
+        output << earliestStepOf[node] << ' ';
+    output << '\n';
+
+    output.close();
+
+    return 0;
+}
@@ -3,6 +3,8 @@
 using namespace std;
 
 
+// recursive version - every node on the current path takes up a stack frame,
+// so long paths (millions of nodes in a chain) overflow the call stack
 void dfs(int sourceNode, const vector<vector<int>> &adjacencyList, int *parentOf, int *distanceFromSource, bool *isVisited) {
     isVisited[sourceNode] = true;
 
@@ -17,6 +19,73 @@ void dfs(int sourceNode, const vector<vector<int>> &adjacencyList, int *parentOf
 }
 
 
+// base visitor, with an empty hook for every event of the traversal;
+// visitors derive from it and hide only the hooks they are interested in,
+// the remaining (empty) ones being inlined away at compile time
+struct DFSVisitor {
+    // 'node' is reached for the first time
+    void discoverNode(int /*node*/) {}
+    // 'adjacentNode' gets discovered through the edge 'node' - 'adjacentNode'
+    void treeEdge(int /*node*/, int /*adjacentNode*/) {}
+    // 'adjacentNode' is on the current path (for undirected graphs, this
+    // includes the tree edge leading back to the parent of 'node')
+    void backEdge(int /*node*/, int /*adjacentNode*/) {}
+    // all nodes reachable from 'node' have been traversed
+    void finishNode(int /*node*/) {}
+};
+
+
+// iterative version - instead of the call stack, an explicit stack holds the
+// current path, alongside the position each node reached in its adjacency list;
+// 'state' marks nodes as unvisited (0), on the current path (1) or finished (2)
+template<typename Visitor>
+void iterativeDFS(int sourceNode, const vector<vector<int>> &adjacencyList, Visitor &visitor, char *state) {
+    // (node, index of the next adjacent node to be checked) pairs
+    vector<pair<int, int>> stack;
+
+    state[sourceNode] = 1;
+    visitor.discoverNode(sourceNode);
+    stack.emplace_back(sourceNode, 0);
+
+    while (not stack.empty()) {
+        int node = stack.back().first;
+        int &nextIndex = stack.back().second;
+
+        if (nextIndex < (int) adjacencyList[node].size()) {
+            int adjacentNode = adjacencyList[node][nextIndex++];
+
+            if (state[adjacentNode] == 0) {
+                visitor.treeEdge(node, adjacentNode);
+                state[adjacentNode] = 1;
+                visitor.discoverNode(adjacentNode);
+                // 'nextIndex' must not be used past this point,
+                // since the push may reallocate the stack
+                stack.emplace_back(adjacentNode, 0);
+            } else if (state[adjacentNode] == 1)
+                visitor.backEdge(node, adjacentNode);
+        }
+        // every adjacent node was checked, so the traversal returns to the previous node
+        else {
+            state[node] = 2;
+            visitor.finishNode(node);
+            stack.pop_back();
+        }
+    }
+}
+
+
+// visitor computing the same DFS tree as the recursive function
+struct TreeBuildingVisitor : DFSVisitor {
+    int *parentOf;
+    int *distanceFromSource;
+
+    void treeEdge(int node, int adjacentNode) {
+        parentOf[adjacentNode] = node;
+        distanceFromSource[adjacentNode] = distanceFromSource[node] + 1;
+    }
+};
+
+
 int main() {
     ifstream input("graf.in");
 
@@ -39,14 +108,15 @@ int main() {
 
     input.close();
 
-    int parentOf[numberOfNodes];
-    int distances[numberOfNodes];
-    bool isVisited[numberOfNodes];
+    vector<int> parentOf(numberOfNodes, -1);
+    vector<int> distances(numberOfNodes, 0);
+    vector<char> state(numberOfNodes, 0);
 
-    for (int i = 0; i < numberOfNodes; i++)
-        isVisited[i] = false;
+    TreeBuildingVisitor visitor;
+    visitor.parentOf = parentOf.data();
+    visitor.distanceFromSource = distances.data();
 
-    dfs(sourceNode, adjacencyList, parentOf, distances,isVisited);
+    iterativeDFS(sourceNode, adjacencyList, visitor, state.data());
 
     // display edges in tree
     for (int node = 0; node < numberOfNodes; node++)
@@ -63,40 +63,221 @@ void getTopologicalOrder(int numberOfNodes, vector<pair<int, int>> *adjacencyLis
 }
 
 
-int getMinimumDistance(int numberOfNodes, int sourceNode, const vector<pair<int, int>> *adjacencyList, const int *topologicalOrder, int *minimumDistanceTo, int *parentOf) {
-    for (int i = 0; i < numberOfNodes; i++)
-        minimumDistanceTo[i] = INT_MAX, parentOf[i] = 0;
-
-    minimumDistanceTo[sourceNode] = 0;
-
-    int i = 0;
-    // ignore nodes before the sourceNode in the topological order
-    for (; i<numberOfNodes && topologicalOrder[i] != sourceNode; i++);
-
-    int currentNode;
-    // traverse the nodes in the topological order
-    for (; i < numberOfNodes; i++) {
-        currentNode = topologicalOrder[i];
-        // only reachable nodes are processed further
-        if (minimumDistanceTo[currentNode] != INT_MIN)
-            // traversing all of its adjacent nodes and updating
-            // their minimum distance wherever necessary
-            for (auto adjacentNode: adjacencyList[currentNode])
-                // a smaller distance to an adjacent node was found
-                if (minimumDistanceTo[currentNode] + adjacentNode.second < minimumDistanceTo[adjacentNode.first])
-                    minimumDistanceTo[adjacentNode.first] =
-                            minimumDistanceTo[currentNode] + adjacentNode.second, parentOf[adjacentNode.first] = currentNode;
+// splits [begin, end) into chunks which are handed out to the threads on demand;
+// 'function(i, threadIndex)' is called for every index, 'threadIndex' being the index of the
+// thread running it, which is useful for accessing per-thread buffers
+template<typename Function>
+void parallelFor(int begin, int end, int numberOfThreads, Function &&function) {
+    // every index is a whole sweep over the graph, so indices are handed out one at a time
+    const int chunkSize = 1;
+
+    // not worth starting any threads
+    if (numberOfThreads == 1 or end - begin <= chunkSize) {
+        for (int i = begin; i < end; i++)
+            function(i, 0);
+        return;
     }
+
+    atomic<int> nextChunk(begin);
+    auto work = [&](int threadIndex) {
+        int chunkBegin;
+        while ((chunkBegin = nextChunk.fetch_add(chunkSize)) < end)
+            for (int i = chunkBegin; i < min(end, chunkBegin + chunkSize); i++)
+                function(i, threadIndex);
+    };
+
+    vector<thread> threads;
+    for (int threadIndex = 1; threadIndex < numberOfThreads; threadIndex++)
+        threads.emplace_back(work, threadIndex);
+    work(0);
+
+    for (auto &worker: threads)
+        worker.join();
 }
 
 
-int main() {
+const long long UNREACHABLE_BY_MINIMUM = LLONG_MAX, UNREACHABLE_BY_MAXIMUM = LLONG_MIN;
+
+
+// the topological order is computed once, and the graph is relabeled by it: node 'position' is
+// 'topologicalOrder[position]', and its edges are 'adjacentPositions[firstEdgeOf[position]]', ...,
+// so every sweep walks through the arrays sequentially, and any number of sweeps can share them
+struct DAGPathEngine {
+    int numberOfNodes;
+    bool isAcyclic;
+    vector<int> topologicalOrder, positionOf;
+    vector<int> firstEdgeOf, adjacentPositions, costs;
+};
+
+
+// returns false if the graph has cycles (in which case the engine can't be used)
+bool buildDAGPathEngine(DAGPathEngine &engine, int numberOfNodes, vector<pair<int, int>> *adjacencyList) {
+    engine.numberOfNodes = numberOfNodes;
+    engine.topologicalOrder.resize(numberOfNodes);
+    getTopologicalOrder(numberOfNodes, adjacencyList, engine.topologicalOrder.data());
+
+    engine.isAcyclic = numberOfNodes == 0 or engine.topologicalOrder[0] != -1;
+    if (not engine.isAcyclic)
+        return false;
+
+    engine.positionOf.resize(numberOfNodes);
+    for (int position = 0; position < numberOfNodes; position++)
+        engine.positionOf[engine.topologicalOrder[position]] = position;
+
+    engine.firstEdgeOf.assign(numberOfNodes + 1, 0);
+    for (int position = 0; position < numberOfNodes; position++)
+        engine.firstEdgeOf[position + 1] =
+                engine.firstEdgeOf[position] + (int) adjacencyList[engine.topologicalOrder[position]].size();
+
+    engine.adjacentPositions.resize(engine.firstEdgeOf[numberOfNodes]);
+    engine.costs.resize(engine.firstEdgeOf[numberOfNodes]);
+    for (int position = 0, edge = 0; position < numberOfNodes; position++)
+        for (auto adjacentNode: adjacencyList[engine.topologicalOrder[position]]) {
+            engine.adjacentPositions[edge] = engine.positionOf[adjacentNode.first];
+            engine.costs[edge++] = adjacentNode.second;
+        }
+
+    return true;
+}
+
+
+// single-source minimum (or maximum, for longest paths) distances, indexed by node; unreachable
+// nodes are left at 'UNREACHABLE_BY_MINIMUM' (or 'UNREACHABLE_BY_MAXIMUM'); 'distanceAt' is
+// a workspace indexed by position, which is reused between calls
+void computeDistancesFrom(const DAGPathEngine &engine, int sourceNode, bool isLongest, vector<long long> &distanceAt,
+                          vector<long long> &distanceTo) {
+    int numberOfNodes = engine.numberOfNodes;
+    long long unreachable = isLongest ? UNREACHABLE_BY_MAXIMUM : UNREACHABLE_BY_MINIMUM;
+    int sourcePosition = engine.positionOf[sourceNode];
+
+    // nodes placed before the source in the topological order can't be reached from it
+    distanceAt.assign(numberOfNodes, unreachable);
+    distanceAt[sourcePosition] = 0;
+
+    for (int position = sourcePosition; position < numberOfNodes; position++) {
+        long long distance = distanceAt[position];
+        if (distance == unreachable)
+            continue;
+
+        for (int edge = engine.firstEdgeOf[position]; edge < engine.firstEdgeOf[position + 1]; edge++) {
+            long long &adjacentDistance = distanceAt[engine.adjacentPositions[edge]];
+            long long newDistance = distance + engine.costs[edge];
+
+            if (isLongest ? (adjacentDistance == unreachable or newDistance > adjacentDistance)
+                          : newDistance < adjacentDistance)
+                adjacentDistance = newDistance;
+        }
+    }
+
+    distanceTo.resize(numberOfNodes);
+    for (int position = 0; position < numberOfNodes; position++)
+        distanceTo[engine.topologicalOrder[position]] = distanceAt[position];
+}
+
+
+// distances from a batch of sources, which are independent and thus split among the threads;
+// 'consume(sourceIndex, distanceTo, threadIndex)' receives the distances from every source,
+// in a buffer owned by the calling thread (which is reused once 'consume' returns)
+template<typename Consumer>
+void computeDistancesFromBatch(const DAGPathEngine &engine, const vector<int> &sourceNodes, bool isLongest,
+                               int numberOfThreads, Consumer &&consume) {
+    vector<vector<long long>> distanceAtOf(numberOfThreads), distanceToOf(numberOfThreads);
+
+    parallelFor(0, (int) sourceNodes.size(), numberOfThreads, [&](int i, int threadIndex) {
+        computeDistancesFrom(engine, sourceNodes[i], isLongest, distanceAtOf[threadIndex], distanceToOf[threadIndex]);
+        consume(i, distanceToOf[threadIndex], threadIndex);
+    });
+}
+
+
+// critical path method, for graphs whose edges are activities (with their costs as durations) and
+// whose nodes are events: the earliest time of an event is the longest path leading to it from any
+// source, while its latest time is the latest moment it can happen without delaying the project
+struct CriticalPathAnalysis {
+    long long projectLength;
+    vector<long long> earliestTimeOf, latestTimeOf;
+    // how much every event can be delayed without delaying the project ('0' for critical events)
+    vector<long long> slackOf;
+    // one of the longest paths, as a list of nodes
+    vector<int> criticalPath;
+};
+
+
+CriticalPathAnalysis analyzeCriticalPath(const DAGPathEngine &engine) {
+    int numberOfNodes = engine.numberOfNodes;
+    CriticalPathAnalysis analysis;
+    analysis.projectLength = 0;
+
+    // forward sweep: earliest times, by position; sources start at 0, while every other event only gets
+    // its time from its predecessors (which come before it), so negative durations are kept as they are
+    vector<char> isSource(numberOfNodes, true);
+    for (auto adjacentPosition: engine.adjacentPositions)
+        isSource[adjacentPosition] = false;
+
+    vector<long long> earliestAt(numberOfNodes), latestAt(numberOfNodes);
+    for (int position = 0; position < numberOfNodes; position++)
+        earliestAt[position] = isSource[position] ? 0 : LLONG_MIN;
+
+    for (int position = 0; position < numberOfNodes; position++) {
+        analysis.projectLength = max(analysis.projectLength, earliestAt[position]);
+        for (int edge = engine.firstEdgeOf[position]; edge < engine.firstEdgeOf[position + 1]; edge++)
+            earliestAt[engine.adjacentPositions[edge]] =
+                    max(earliestAt[engine.adjacentPositions[edge]], earliestAt[position] + engine.costs[edge]);
+    }
+
+    // backward sweep: latest times, every sink being due at the end of the project
+    for (int position = numberOfNodes - 1; position >= 0; position--) {
+        latestAt[position] = analysis.projectLength;
+        for (int edge = engine.firstEdgeOf[position]; edge < engine.firstEdgeOf[position + 1]; edge++)
+            latestAt[position] = min(latestAt[position], latestAt[engine.adjacentPositions[edge]] - engine.costs[edge]);
+    }
+
+    analysis.earliestTimeOf.resize(numberOfNodes);
+    analysis.latestTimeOf.resize(numberOfNodes);
+    analysis.slackOf.resize(numberOfNodes);
+    for (int position = 0; position < numberOfNodes; position++) {
+        int node = engine.topologicalOrder[position];
+        analysis.earliestTimeOf[node] = earliestAt[position];
+        analysis.latestTimeOf[node] = latestAt[position];
+        analysis.slackOf[node] = latestAt[position] - earliestAt[position];
+    }
+
+    // the critical path starts at a critical source and follows tight edges between critical events
+    int position = 0;
+    while (position < numberOfNodes and (not isSource[position] or latestAt[position] != 0))
+        position++;
+
+    while (position < numberOfNodes) {
+        analysis.criticalPath.push_back(engine.topologicalOrder[position]);
+
+        int nextPosition = numberOfNodes;
+        for (int edge = engine.firstEdgeOf[position]; edge < engine.firstEdgeOf[position + 1]; edge++) {
+            int adjacentPosition = engine.adjacentPositions[edge];
+            if (earliestAt[adjacentPosition] == latestAt[adjacentPosition] and
+                earliestAt[position] + engine.costs[edge] == earliestAt[adjacentPosition]) {
+                nextPosition = adjacentPosition;
+                break;
+            }
+        }
+        position = nextPosition;
+    }
+
+    return analysis;
+}
+
+
+// the number of threads may be given as the first argument (all cores by default)
+int main(int argc, char **argv) {
+    int numberOfThreads = argc > 1 ? atoi(argv[1]) : (int) thread::hardware_concurrency();
+    numberOfThreads = max(numberOfThreads, 1);
+
     int numberOfNodes, numberOfEdges, firstNode, secondNode, cost, startNode;
 
     ifstream input("easygraph.in");
     ofstream output("easygraph.out");
 
     input >> startNode >> numberOfNodes >> numberOfEdges;
+    startNode--;
 
     vector<pair<int, int>> adjacencyList[numberOfNodes];
     for (int j = 0; j < numberOfEdges; j++) {
@@ -106,15 +287,66 @@ int main() {
         adjacencyList[firstNode].emplace_back(secondNode, cost);
     }
 
-    int topologicalOrder[numberOfNodes];
-    getTopologicalOrder(numberOfNodes, adjacencyList, topologicalOrder);
+    // optionally, a batch of sources, whose longest distances are needed
+    int numberOfSources = 0;
+    input >> numberOfSources;
+    vector<int> sourceNodes(max(numberOfSources, 0));
+    for (auto &sourceNode: sourceNodes) {
+        input >> sourceNode;
+        sourceNode--;
+    }
 
-    int minimumDistanceTo[numberOfNodes], parentOf[numberOfNodes];
-    output << getMinimumDistance(numberOfNodes, startNode, adjacencyList, topologicalOrder, minimumDistanceTo,
-                                 parentOf);
+    DAGPathEngine engine;
+    if (not buildDAGPathEngine(engine, numberOfNodes, adjacencyList)) {
+        output << -1 << '\n';
+        output.close();
+        input.close();
+        return 0;
+    }
+
+    auto writeDistances = [&](const vector<long long> &distanceTo, long long unreachable) {
+        for (int node = 0; node < numberOfNodes; node++)
+            if (distanceTo[node] == unreachable)
+                output << "inf ";
+            else
+                output << distanceTo[node] << ' ';
+        output << '\n';
+    };
+
+    // minimum distances from the start node ('inf' for unreachable nodes)
+    vector<long long> distanceAt, distanceTo;
+    computeDistancesFrom(engine, startNode, false, distanceAt, distanceTo);
+    writeDistances(distanceTo, UNREACHABLE_BY_MINIMUM);
+
+    // critical path analysis: the length of the project, the slack of every
+    // event and one of the critical paths
+    CriticalPathAnalysis analysis = analyzeCriticalPath(engine);
+    output << analysis.projectLength << '\n';
+    for (int node = 0; node < numberOfNodes; node++)
+        output << analysis.slackOf[node] << ' ';
+    output << '\n';
+    for (auto node: analysis.criticalPath)
+        output << node + 1 << ' ';
+    output << '\n';
+
+    // longest distances from every source of the batch, in the order of the sources
+    vector<vector<long long>> longestDistancesFrom(sourceNodes.size());
+    auto start = chrono::steady_clock::now();
+    computeDistancesFromBatch(engine, sourceNodes, true, numberOfThreads,
+                              [&](int sourceIndex, const vector<long long> &longestDistanceTo, int /*threadIndex*/) {
+                                  longestDistancesFrom[sourceIndex] = longestDistanceTo;
+                              });
+    auto finish = chrono::steady_clock::now();
+
+    if (not sourceNodes.empty())
+        cerr << sourceNodes.size() << " sources, " << numberOfThreads << " threads: "
+             << chrono::duration_cast<chrono::milliseconds>(finish - start).count() << " ms\n";
+
+    for (auto &longestDistanceTo: longestDistancesFrom)
+        writeDistances(longestDistanceTo, UNREACHABLE_BY_MAXIMUM);
 
     output.close();
     input.close();
 
     return 0;
-}
\ No newline at end of file
+}
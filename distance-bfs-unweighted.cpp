@@ -1,60 +1,256 @@
-// O(k(m+n)) - k DFS traversals, where k is the number of control points
+// O(m+n) - a single multi-source BFS traversal, seeded with every control point
+// O(k(m+n)) - when the k nearest control points of every node are requested
 #include <bits/stdc++.h>
 
 using namespace std;
 
 
-// modified BFS function
-void bfs(int controlPoint, int numberOfNodes, vector<int> *adjacencyList, const bool *isControlPoint,
-         int *distance) {
+// multi-source BFS function;
+// since every edge has the same length, starting the traversal from all control
+// points at once guarantees that nodes are popped from the queue in increasing
+// order of their distance to the closest control point, which means that the first
+// time a node is reached, it is reached from (one of) its nearest control point(s)
+void multiSourceBFS(int numberOfNodes, const vector<int> *adjacencyList, const bool *isControlPoint,
+                    int *distance, int *nearestControlPoint) {
     int currentNode;
     queue<int> workingQueue;
-    bool isVisited[numberOfNodes];
 
+    // '-1' marks the distance from 'node' to a control point as not yet known,
+    // which also doubles as the 'isVisited' array of the traversal
+    for (int node = 0; node < numberOfNodes; node++) {
+        distance[node] = -1;
+        nearestControlPoint[node] = -1;
+    }
+
+    // all control points are pushed before the traversal begins, as the
+    // roots of their own BFS trees
     for (int node = 0; node < numberOfNodes; node++)
-        isVisited[node] = false;
+        if (isControlPoint[node]) {
+            workingQueue.push(node);
+            distance[node] = 0;
+            nearestControlPoint[node] = node;
+        }
+
+    while (not workingQueue.empty()) {
+        currentNode = workingQueue.front();
+        workingQueue.pop();
+
+        for (auto adjacentNode: adjacencyList[currentNode])
+            // an adjacent node whose distance is already known was reached
+            // from a control point at least as close as the current one
+            if (distance[adjacentNode] == -1) {
+                workingQueue.push(adjacentNode);
+
+                // the adjacent node inherits the control point of the BFS tree
+                // it was reached through, alongside the incremented distance
+                distance[adjacentNode] = distance[currentNode] + 1;
+                nearestControlPoint[adjacentNode] = nearestControlPoint[currentNode];
+            }
+    }
+}
+
+
+// multi-source BFS function, in which every node may be reached by at most
+// k distinct control points (instead of just one);
+// queue entries are still popped in increasing order of their distance, so the
+// first k distinct control points reaching a node are its k nearest ones;
+// only the arrivals which are accepted are propagated any further, which means
+// that every node gets expanded at most k times
+vector<vector<pair<int, int>>> kNearestControlPoints(int numberOfNodes, const vector<int> *adjacencyList,
+                                                     const bool *isControlPoint, int k) {
+    // the accepted (control point, distance) pairs of every node, in increasing order of distance
+    vector<vector<pair<int, int>>> nearestControlPoints(numberOfNodes);
+    // (node, control point, distance) triplets
+    queue<tuple<int, int, int>> workingQueue;
+
+    if (k <= 0)
+        return nearestControlPoints;
+
+    for (int node = 0; node < numberOfNodes; node++)
+        if (isControlPoint[node]) {
+            nearestControlPoints[node].emplace_back(node, 0);
+            workingQueue.emplace(node, node, 0);
+        }
+
+    int currentNode, controlPoint, currentDistance;
+    while (not workingQueue.empty()) {
+        tie(currentNode, controlPoint, currentDistance) = workingQueue.front();
+        workingQueue.pop();
+
+        for (auto adjacentNode: adjacencyList[currentNode]) {
+            auto &accepted = nearestControlPoints[adjacentNode];
+
+            // the adjacent node already knows of its k nearest control points
+            if ((int) accepted.size() >= k)
+                continue;
+
+            // the same control point may reach a node through several paths,
+            // but only the first (and shortest) one is of any interest; since
+            // k is expected to be small, a linear scan is enough
+            bool alreadyAccepted = false;
+            for (auto &entry: accepted)
+                if (entry.first == controlPoint) {
+                    alreadyAccepted = true;
+                    break;
+                }
+
+            if (not alreadyAccepted) {
+                accepted.emplace_back(controlPoint, currentDistance + 1);
+                workingQueue.emplace(adjacentNode, controlPoint, currentDistance + 1);
+            }
+        }
+    }
+
+    return nearestControlPoints;
+}
+
+
+// distances and nearest control point labels which are kept up to date
+// while control points are opened and closed;
+// every node that isn't a control point and has a known distance 'd' has at least
+// one adjacent node with the same label and a distance of 'd-1', which means that
+// all nodes labelled with the same control point form a connected region around it
+struct ControlPointDistances {
+    int numberOfNodes;
+    const vector<int> *adjacencyList;
+    vector<bool> isControlPoint;
+    vector<int> distance;
+    vector<int> nearestControlPoint;
+    // marks the nodes touched by the latest update, so that no
+    // n-sized array has to be cleared before every update
+    vector<int> lastUpdatedBy;
+    int currentUpdate;
+};
+
+
+void initializeControlPointDistances(ControlPointDistances &state, int numberOfNodes,
+                                     const vector<int> *adjacencyList, const bool *isControlPoint) {
+    state.numberOfNodes = numberOfNodes;
+    state.adjacencyList = adjacencyList;
+    state.isControlPoint.assign(isControlPoint, isControlPoint + numberOfNodes);
+    state.distance.assign(numberOfNodes, -1);
+    state.nearestControlPoint.assign(numberOfNodes, -1);
+    state.lastUpdatedBy.assign(numberOfNodes, 0);
+    state.currentUpdate = 0;
+
+    multiSourceBFS(numberOfNodes, adjacencyList, isControlPoint, state.distance.data(),
+                   state.nearestControlPoint.data());
+}
+
 
-    // beginning of BFS
+// O(size of the region which is now closer to the new control point) - a BFS wave
+// starting from the new control point, which stops wherever it cannot improve
+void addControlPoint(ControlPointDistances &state, int controlPoint) {
+    if (state.isControlPoint[controlPoint])
+        return;
+
+    int update = ++state.currentUpdate;
+    queue<int> workingQueue;
+
+    state.isControlPoint[controlPoint] = true;
+    state.distance[controlPoint] = 0;
+    state.nearestControlPoint[controlPoint] = controlPoint;
+    state.lastUpdatedBy[controlPoint] = update;
     workingQueue.push(controlPoint);
-    isVisited[controlPoint] = true;
 
+    int currentNode;
     while (not workingQueue.empty()) {
         currentNode = workingQueue.front();
         workingQueue.pop();
 
-        // traversing all adjacent nodes to the current node
-        for (auto adjacentNode: adjacencyList[currentNode]) {
-            // an adjacent node is added to the queue only if it meets the following criteria:
-            //  - it hasn't been visited before (else an infinite loop would occur)
-            //  - it isn't a control point (all adjacent nodes to other control points
-            // are closer to them and their distance either was or will be computed
-            // during their corresponding control point BFS traversal)
-            //  - its distance wasn't computed relative to any other control point yet
-            //  - its distance relative to another control point was computed, and it is
-            // longer than the distance to the current control point (it is pointless to
-            // traverse the adjacent node's adjacent nodes, since all of their distances
-            // will be shorter relative to the current control point)
-            if (not isVisited[adjacentNode] and
-                not isControlPoint[adjacentNode] and (distance[adjacentNode] != -1 and
-                                                      distance[currentNode] + 1 < distance[adjacentNode] or
-                                                      distance[adjacentNode] == -1)) {
+        for (auto adjacentNode: state.adjacencyList[currentNode])
+            // ties are also taken over by the new control point: otherwise, a node
+            // whose only adjacent node sharing its label got taken over could end up
+            // disconnected from the region of its own control point
+            if (state.lastUpdatedBy[adjacentNode] != update and
+                (state.distance[adjacentNode] == -1 or
+                 state.distance[currentNode] + 1 <= state.distance[adjacentNode])) {
 
+                state.lastUpdatedBy[adjacentNode] = update;
+                state.distance[adjacentNode] = state.distance[currentNode] + 1;
+                state.nearestControlPoint[adjacentNode] = controlPoint;
                 workingQueue.push(adjacentNode);
-                // marking adjacent node as 'visited' in advance to prevent other nodes
-                // which are also adjacent to it from adding it repeatedly to the queue;
-                isVisited[adjacentNode] = true;
+            }
+    }
+}
 
-                // the distance from the root control point to the adjacent node is
-                // the incremented distance from the current node to it, since only
-                // one more edge was crossed to reach it;
-                distance[adjacentNode] = distance[currentNode] + 1;
+
+// O(r*log(r)) - r being the number of edges incident to the region of the
+// removed control point; only said region has to be recomputed, since the
+// distances of all the other nodes can't get any shorter
+void removeControlPoint(ControlPointDistances &state, int controlPoint) {
+    if (not state.isControlPoint[controlPoint])
+        return;
+
+    int update = ++state.currentUpdate;
+    vector<int> orphanedRegion;
+    state.isControlPoint[controlPoint] = false;
+
+    // collecting the (connected) region labelled with the removed control point
+    state.lastUpdatedBy[controlPoint] = update;
+    orphanedRegion.push_back(controlPoint);
+    for (int i = 0; i < (int) orphanedRegion.size(); i++)
+        for (auto adjacentNode: state.adjacencyList[orphanedRegion[i]])
+            if (state.lastUpdatedBy[adjacentNode] != update and
+                state.nearestControlPoint[adjacentNode] == controlPoint) {
+                state.lastUpdatedBy[adjacentNode] = update;
+                orphanedRegion.push_back(adjacentNode);
+            }
+
+    for (auto node: orphanedRegion) {
+        state.distance[node] = -1;
+        state.nearestControlPoint[node] = -1;
+    }
+
+    // every edge leaving the region is a candidate entry point for
+    // the control point on its other end: (distance, node, control point)
+    vector<tuple<int, int, int>> entryPoints;
+    for (auto node: orphanedRegion)
+        for (auto adjacentNode: state.adjacencyList[node])
+            if (state.lastUpdatedBy[adjacentNode] != update and state.distance[adjacentNode] != -1)
+                entryPoints.emplace_back(state.distance[adjacentNode] + 1, node,
+                                         state.nearestControlPoint[adjacentNode]);
+
+    sort(entryPoints.begin(), entryPoints.end());
+
+    // BFS restricted to the region; the sorted entry points and the queue are
+    // merged, so that nodes are still settled in increasing order of distance
+    queue<int> workingQueue;
+    int nextEntryPoint = 0, currentNode;
+    while (nextEntryPoint < (int) entryPoints.size() or not workingQueue.empty()) {
+        if (workingQueue.empty() or (nextEntryPoint < (int) entryPoints.size() and
+                                     get<0>(entryPoints[nextEntryPoint]) <=
+                                     state.distance[workingQueue.front()])) {
+            int entryDistance, node, nearest;
+            tie(entryDistance, node, nearest) = entryPoints[nextEntryPoint++];
+
+            if (state.distance[node] == -1) {
+                state.distance[node] = entryDistance;
+                state.nearestControlPoint[node] = nearest;
+                workingQueue.push(node);
             }
+
+            continue;
         }
+
+        currentNode = workingQueue.front();
+        workingQueue.pop();
+
+        for (auto adjacentNode: state.adjacencyList[currentNode])
+            if (state.lastUpdatedBy[adjacentNode] == update and state.distance[adjacentNode] == -1) {
+                state.distance[adjacentNode] = state.distance[currentNode] + 1;
+                state.nearestControlPoint[adjacentNode] = state.nearestControlPoint[currentNode];
+                workingQueue.push(adjacentNode);
+            }
     }
 }
 
 
-int main() {
+// the number of nearest control points to list for every node may be given as the first argument
+// (none by default, since the control points are read up to the end of the input file)
+int main(int argc, char **argv) {
+    int numberOfNearestControlPoints = argc > 1 ? atoi(argv[1]) : 0;
+
     int numberOfNodes, numberOfEdges, firstNode, secondNode;
     ifstream input;
 
@@ -66,13 +262,11 @@ int main() {
     vector<int> adjacencyList[numberOfNodes];
     bool isControlPoint[numberOfNodes];
     int shortestDistanceToControlPoint[numberOfNodes];
+    int nearestControlPoint[numberOfNodes];
 
     // initializing arrays
-    for (int node = 0; node < numberOfNodes; node++) {
+    for (int node = 0; node < numberOfNodes; node++)
         isControlPoint[node] = false;
-        // '-1' marks the distance from 'node' to a control point as not yet known
-        shortestDistanceToControlPoint[node] = -1;
-    }
 
     // reading and storing edge data
     for (int edge = 0; edge < numberOfEdges; edge++) {
@@ -82,29 +276,43 @@ int main() {
     }
 
     // reading and storing control point data
-    while (input >> firstNode) {
+    while (input >> firstNode)
         isControlPoint[firstNode - 1] = true;
-        shortestDistanceToControlPoint[firstNode - 1] = 0;
-    }
 
     input.close();
 
 
-    // a (partial) BFS will be performed starting from every control point
-    for (int node = 0; node < numberOfNodes; node++) {
-        if (isControlPoint[node])
-            bfs(node, numberOfNodes, adjacencyList, isControlPoint, shortestDistanceToControlPoint);
-    }
+    // a single BFS, starting from all control points at once
+    multiSourceBFS(numberOfNodes, adjacencyList, isControlPoint, shortestDistanceToControlPoint,
+                   nearestControlPoint);
 
 
-    // writing result to file
+    // writing result to file: the distance from every node to its nearest control point ('-1' if none can be
+    // reached), then that control point ('0' if none can be reached) and, if requested, one line per node with
+    // its nearest control points, as 'node: controlPoint/distance ...'
     ofstream output;
     output.open("graf.out");
 
     for (int node = 0; node < numberOfNodes; node++)
         output << shortestDistanceToControlPoint[node] << ' ';
+    output << '\n';
+
+    for (int node = 0; node < numberOfNodes; node++)
+        output << nearestControlPoint[node] + 1 << ' ';
+    output << '\n';
+
+    if (numberOfNearestControlPoints > 0) {
+        auto nearestControlPoints = kNearestControlPoints(numberOfNodes, adjacencyList, isControlPoint,
+                                                          numberOfNearestControlPoints);
+        for (int node = 0; node < numberOfNodes; node++) {
+            output << node + 1 << ':';
+            for (auto &entry: nearestControlPoints[node])
+                output << ' ' << entry.first + 1 << '/' << entry.second;
+            output << '\n';
+        }
+    }
 
     output.close();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,324 @@
+// Dominator tree of a directed flow graph (Lengauer-Tarjan, with path compression)
+// O(m*log(n)) - iterative DFS numbering, then semidominators computed in reverse DFS
+// order, over a forest whose paths are compressed whenever they are evaluated
+// O(m + size of the frontiers) - dominance frontiers (Cooper, Harvey and Kennedy),
+// walking up the dominator tree from the predecessors of every join node
+//
+//      Node d dominates node v if every path from the root to v passes through d;
+// the immediate dominator of v is its closest strict dominator, and linking every
+// node to it forms the dominator tree. The dominance frontier of d holds the nodes
+// which d doesn't strictly dominate, but one of whose predecessors it dominates.
+#include <bits/stdc++.h>
+
+using namespace std;
+
+
+// buffered reader for large inputs: the file is read in blocks of 64KB,
+// instead of parsing one token at a time through 'ifstream'
+struct InputReader {
+    FILE *file;
+    char buffer[1 << 16];
+    int size = 0, position = 0;
+
+    explicit InputReader(const char *fileName) : file(fopen(fileName, "r")) {}
+
+    ~InputReader() {
+        if (file)
+            fclose(file);
+    }
+
+    int nextCharacter() {
+        if (position == size) {
+            size = (int) fread(buffer, 1, sizeof(buffer), file);
+            position = 0;
+            if (size <= 0)
+                return EOF;
+        }
+        return (unsigned char) buffer[position++];
+    }
+
+    // returns false once the end of the file is reached
+    bool readInt(int &value) {
+        int character = nextCharacter();
+        while (character != EOF and character != '-' and not isdigit(character))
+            character = nextCharacter();
+        if (character == EOF)
+            return false;
+
+        bool isNegative = character == '-';
+        if (isNegative)
+            character = nextCharacter();
+
+        value = 0;
+        for (; character != EOF and isdigit(character); character = nextCharacter())
+            value = value * 10 + (character - '0');
+        if (isNegative)
+            value = -value;
+
+        return true;
+    }
+};
+
+
+// compressed adjacency list: the adjacent nodes of 'node' are
+// 'adjacentNodes[firstEdgeOf[node]]', ..., 'adjacentNodes[firstEdgeOf[node + 1] - 1]'
+void buildCompressedAdjacencyList(int numberOfNodes, const vector<int> &outNodes, const vector<int> &inNodes,
+                                  vector<int> &firstEdgeOf, vector<int> &adjacentNodes) {
+    firstEdgeOf.assign(numberOfNodes + 1, 0);
+    adjacentNodes.resize(outNodes.size());
+
+    for (auto node: outNodes)
+        firstEdgeOf[node + 1]++;
+    for (int node = 0; node < numberOfNodes; node++)
+        firstEdgeOf[node + 1] += firstEdgeOf[node];
+
+    vector<int> nextPosition(firstEdgeOf.begin(), firstEdgeOf.end() - 1);
+    for (int edge = 0; edge < (int) outNodes.size(); edge++)
+        adjacentNodes[nextPosition[outNodes[edge]]++] = inNodes[edge];
+}
+
+
+struct DominatorTree {
+    // all arrays below, except 'numberOf', are indexed by DFS number
+    vector<int> numberOf;       // DFS number of every node ('-1' if unreachable from the root)
+    vector<int> nodeAt;         // node with every DFS number
+    vector<int> parentOf;       // parent in the DFS tree
+    vector<int> semidominatorOf;
+    vector<int> immediateDominatorOf;
+    // forest built while processing nodes in reverse DFS order: the ancestor of every
+    // node in the forest ('-1' for roots), and the node with the smallest semidominator
+    // on the (compressed) path leading to it
+    vector<int> ancestorOf, labelOf;
+    // bucket of every node: the nodes it is the semidominator of, as linked lists
+    vector<int> firstInBucket, nextInBucket;
+    // reused by 'compress', so that no allocation happens per evaluation
+    vector<int> pathStack;
+};
+
+
+// iterative version of the recursive path compression: the path is first collected,
+// then compressed from its top (the nodes closest to the root of the forest) downwards
+void compress(DominatorTree &tree, int node) {
+    auto &ancestorOf = tree.ancestorOf;
+    auto &labelOf = tree.labelOf;
+    auto &semidominatorOf = tree.semidominatorOf;
+
+    while (ancestorOf[ancestorOf[node]] != -1) {
+        tree.pathStack.push_back(node);
+        node = ancestorOf[node];
+    }
+
+    while (not tree.pathStack.empty()) {
+        node = tree.pathStack.back();
+        tree.pathStack.pop_back();
+
+        int ancestor = ancestorOf[node];
+        if (semidominatorOf[labelOf[ancestor]] < semidominatorOf[labelOf[node]])
+            labelOf[node] = labelOf[ancestor];
+        ancestorOf[node] = ancestorOf[ancestor];
+    }
+}
+
+
+// node with the smallest semidominator on the forest path leading to 'node'
+int evaluate(DominatorTree &tree, int node) {
+    if (tree.ancestorOf[node] == -1)
+        return node;
+
+    compress(tree, node);
+    return tree.labelOf[node];
+}
+
+
+// returns the immediate dominator of every node ('-1' for the root and for unreachable nodes)
+vector<int> computeDominatorTree(int numberOfNodes, int root, const vector<int> &firstOutEdgeOf,
+                                 const vector<int> &outNodes, const vector<int> &firstInEdgeOf,
+                                 const vector<int> &inNodes) {
+    DominatorTree tree;
+    tree.numberOf.assign(numberOfNodes, -1);
+
+    // iterative DFS numbering, with (node, next edge) pairs on the stack
+    vector<pair<int, int>> stack;
+    tree.numberOf[root] = 0;
+    tree.nodeAt.push_back(root);
+    tree.parentOf.push_back(-1);
+    stack.emplace_back(root, firstOutEdgeOf[root]);
+
+    while (not stack.empty()) {
+        int node = stack.back().first;
+        int &edge = stack.back().second;
+
+        if (edge == firstOutEdgeOf[node + 1]) {
+            stack.pop_back();
+            continue;
+        }
+
+        int adjacentNode = outNodes[edge++];
+        if (tree.numberOf[adjacentNode] == -1) {
+            tree.numberOf[adjacentNode] = (int) tree.nodeAt.size();
+            tree.nodeAt.push_back(adjacentNode);
+            tree.parentOf.push_back(tree.numberOf[node]);
+            stack.emplace_back(adjacentNode, firstOutEdgeOf[adjacentNode]);
+        }
+    }
+
+    int numberOfReachableNodes = (int) tree.nodeAt.size();
+    tree.semidominatorOf.resize(numberOfReachableNodes);
+    tree.immediateDominatorOf.assign(numberOfReachableNodes, 0);
+    tree.ancestorOf.assign(numberOfReachableNodes, -1);
+    tree.labelOf.resize(numberOfReachableNodes);
+    tree.firstInBucket.assign(numberOfReachableNodes, -1);
+    tree.nextInBucket.assign(numberOfReachableNodes, -1);
+
+    for (int number = 0; number < numberOfReachableNodes; number++)
+        tree.semidominatorOf[number] = tree.labelOf[number] = number;
+
+    for (int number = numberOfReachableNodes - 1; number > 0; number--) {
+        int node = tree.nodeAt[number];
+
+        // the semidominator is the smallest among the DFS numbers of the predecessors
+        // and the semidominators of the nodes above them, within the processed part
+        for (int edge = firstInEdgeOf[node]; edge < firstInEdgeOf[node + 1]; edge++) {
+            int predecessor = tree.numberOf[inNodes[edge]];
+            if (predecessor == -1)
+                continue;
+
+            int smallest = evaluate(tree, predecessor);
+            if (tree.semidominatorOf[smallest] < tree.semidominatorOf[number])
+                tree.semidominatorOf[number] = tree.semidominatorOf[smallest];
+        }
+
+        int semidominator = tree.semidominatorOf[number];
+        tree.nextInBucket[number] = tree.firstInBucket[semidominator];
+        tree.firstInBucket[semidominator] = number;
+
+        int parent = tree.parentOf[number];
+        tree.ancestorOf[number] = parent;
+
+        // every node whose semidominator is the parent has its immediate dominator either
+        // settled (the parent itself) or deferred to that of another node with the same one
+        for (int bucketNode = tree.firstInBucket[parent]; bucketNode != -1;
+             bucketNode = tree.nextInBucket[bucketNode]) {
+            int smallest = evaluate(tree, bucketNode);
+            tree.immediateDominatorOf[bucketNode] =
+                    tree.semidominatorOf[smallest] < tree.semidominatorOf[bucketNode] ? smallest : parent;
+        }
+        tree.firstInBucket[parent] = -1;
+    }
+
+    // resolving the deferred immediate dominators, in DFS order
+    for (int number = 1; number < numberOfReachableNodes; number++)
+        if (tree.immediateDominatorOf[number] != tree.semidominatorOf[number])
+            tree.immediateDominatorOf[number] = tree.immediateDominatorOf[tree.immediateDominatorOf[number]];
+
+    vector<int> immediateDominatorOf(numberOfNodes, -1);
+    for (int number = 1; number < numberOfReachableNodes; number++)
+        immediateDominatorOf[tree.nodeAt[number]] = tree.nodeAt[tree.immediateDominatorOf[number]];
+
+    return immediateDominatorOf;
+}
+
+
+// dominance frontiers, in compressed form: the frontier of 'node' is
+// 'frontierNodes[firstFrontierNodeOf[node]]', ..., 'frontierNodes[firstFrontierNodeOf[node + 1] - 1]'
+void computeDominanceFrontiers(int numberOfNodes, int root, const vector<int> &immediateDominatorOf,
+                               const vector<int> &firstInEdgeOf, const vector<int> &inNodes,
+                               vector<int> &firstFrontierNodeOf, vector<int> &frontierNodes) {
+    // (node, frontier node) pairs
+    vector<pair<int, int>> frontierPairs;
+    // the last join node added to the frontier of every node, so that it is only added once
+    vector<int> lastAddedTo(numberOfNodes, -1);
+
+    auto isReachable = [&](int node) { return node == root or immediateDominatorOf[node] != -1; };
+
+    // a node with a single predecessor is immediately dominated by it, so only
+    // join nodes (and the root, which has no immediate dominator) are considered
+    for (int node = 0; node < numberOfNodes; node++) {
+        if (not isReachable(node) or (node != root and firstInEdgeOf[node + 1] - firstInEdgeOf[node] < 2))
+            continue;
+
+        // every node on the way up from a predecessor to the immediate dominator of
+        // the join node dominates that predecessor, but not the join node itself
+        for (int edge = firstInEdgeOf[node]; edge < firstInEdgeOf[node + 1]; edge++) {
+            int runner = inNodes[edge];
+            if (not isReachable(runner))
+                continue;
+
+            while (runner != immediateDominatorOf[node] and lastAddedTo[runner] != node) {
+                lastAddedTo[runner] = node;
+                frontierPairs.emplace_back(runner, node);
+                if (runner == root)
+                    break;
+                runner = immediateDominatorOf[runner];
+            }
+        }
+    }
+
+    firstFrontierNodeOf.assign(numberOfNodes + 1, 0);
+    frontierNodes.resize(frontierPairs.size());
+    for (auto &frontierPair: frontierPairs)
+        firstFrontierNodeOf[frontierPair.first + 1]++;
+    for (int node = 0; node < numberOfNodes; node++)
+        firstFrontierNodeOf[node + 1] += firstFrontierNodeOf[node];
+
+    vector<int> nextPosition(firstFrontierNodeOf.begin(), firstFrontierNodeOf.end() - 1);
+    for (auto &frontierPair: frontierPairs)
+        frontierNodes[nextPosition[frontierPair.first]++] = frontierPair.second;
+}
+
+
+int main() {
+    // number of nodes and edges, followed by the (directed) edges and the root
+    InputReader input("dominator.in");
+    if (not input.file) {
+        cerr << "can't open dominator.in\n";
+        return 1;
+    }
+
+    int numberOfNodes, numberOfEdges, root;
+    input.readInt(numberOfNodes);
+    input.readInt(numberOfEdges);
+
+    vector<int> outNodes(numberOfEdges), inNodes(numberOfEdges);
+    for (int i = 0; i < numberOfEdges; i++) {
+        input.readInt(outNodes[i]);
+        input.readInt(inNodes[i]);
+        outNodes[i]--;
+        inNodes[i]--;
+    }
+
+    input.readInt(root);
+    root--;
+
+    vector<int> firstOutEdgeOf, adjacentOutNodes, firstInEdgeOf, adjacentInNodes;
+    buildCompressedAdjacencyList(numberOfNodes, outNodes, inNodes, firstOutEdgeOf, adjacentOutNodes);
+    buildCompressedAdjacencyList(numberOfNodes, inNodes, outNodes, firstInEdgeOf, adjacentInNodes);
+
+    vector<int>().swap(outNodes);
+    vector<int>().swap(inNodes);
+
+    vector<int> immediateDominatorOf = computeDominatorTree(numberOfNodes, root, firstOutEdgeOf, adjacentOutNodes,
+                                                            firstInEdgeOf, adjacentInNodes);
+
+    vector<int> firstFrontierNodeOf, frontierNodes;
+    computeDominanceFrontiers(numberOfNodes, root, immediateDominatorOf, firstInEdgeOf, adjacentInNodes,
+                              firstFrontierNodeOf, frontierNodes);
+
+    ofstream output("dominator.out");
+
+    // immediate dominator of every node ('0' for the root and for unreachable nodes)
+    for (int node = 0; node < numberOfNodes; node++)
+        output << immediateDominatorOf[node] + 1 << ' ';
+    output << '\n';
+
+    // dominance frontier of every node, one per line
+    for (int node = 0; node < numberOfNodes; node++) {
+        for (int i = firstFrontierNodeOf[node]; i < firstFrontierNodeOf[node + 1]; i++)
+            output << frontierNodes[i] + 1 << ' ';
+        output << '\n';
+    }
+
+    output.close();
+
+    return 0;
+}
@@ -0,0 +1,400 @@
+// Enumeration of the elementary cycles of a directed graph (Johnson's algorithm)
+// O((n + m) * (c + 1)) time for c cycles, O(n + m) memory no matter how many cycles there are:
+// - the graph is split into SCCs, since every cycle lies inside one of them
+// - inside an SCC, every cycle through a chosen start node is found by a DFS from it; nodes which
+// failed to lead back to the start stay blocked until one of their successors gets unblocked, so
+// no dead end is explored twice; afterwards the start node is removed, and what is left of the SCC
+// is split into SCCs again once a search finds no cycle (or once half of the SCC is gone); a search
+// inside an SCC always finds a cycle, so every split and every fruitless search follows a search
+// which found one, which keeps the O(n + m) cost of each of them within the bound
+// - cycles are handed to a callback as soon as they are found, instead of being stored
+//
+//      With a maximum length, a search cut short by the limit can't prove that a node is unable to
+// lead back to the start (it might, through a longer path), so it is treated as if it found a cycle
+// and doesn't keep anything blocked; this keeps the enumeration complete, at the cost of some pruning.
+// Such searches count like cycles in the time bound, since they don't necessarily find any.
+#include <bits/stdc++.h>
+
+using namespace std;
+
+
+// compressed adjacency list, without parallel edges: the adjacent nodes of 'node' are
+// 'adjacentNodes[firstEdgeOf[node]]', ..., 'adjacentNodes[firstEdgeOf[node + 1] - 1]'
+void buildCompressedAdjacencyList(int numberOfNodes, const vector<int> &outNodes, const vector<int> &inNodes,
+                                  vector<int> &firstEdgeOf, vector<int> &adjacentNodes) {
+    firstEdgeOf.assign(numberOfNodes + 1, 0);
+    adjacentNodes.resize(outNodes.size());
+
+    for (auto node: outNodes)
+        firstEdgeOf[node + 1]++;
+    for (int node = 0; node < numberOfNodes; node++)
+        firstEdgeOf[node + 1] += firstEdgeOf[node];
+
+    vector<int> nextPosition(firstEdgeOf.begin(), firstEdgeOf.end() - 1);
+    for (int edge = 0; edge < (int) outNodes.size(); edge++)
+        adjacentNodes[nextPosition[outNodes[edge]]++] = inNodes[edge];
+
+    // parallel edges would make the same cycle come up once for every edge, so they are merged,
+    // compacting the lists in place
+    int nextEdge = 0;
+    for (int node = 0; node < numberOfNodes; node++) {
+        int begin = firstEdgeOf[node], end = firstEdgeOf[node + 1];
+        sort(adjacentNodes.begin() + begin, adjacentNodes.begin() + end);
+
+        firstEdgeOf[node] = nextEdge;
+        for (int edge = begin; edge < end; edge++)
+            if (edge == begin or adjacentNodes[edge] != adjacentNodes[edge - 1])
+                adjacentNodes[nextEdge++] = adjacentNodes[edge];
+    }
+    firstEdgeOf[numberOfNodes] = nextEdge;
+    adjacentNodes.resize(nextEdge);
+}
+
+
+struct ElementaryCycleSearch {
+    int numberOfNodes;
+    const vector<int> *firstEdgeOf, *adjacentNodes;
+    // the out-node of every edge
+    vector<int> edgeSourceOf;
+    // the set (SCC) every node currently belongs to; only edges inside the set being searched are followed
+    vector<int> setOf;
+    int numberOfSets;
+    // Tarjan's indices, used while splitting a set into SCCs ('-1' outside of the splits)
+    vector<int> indexOf, lowOf;
+    vector<char> isOnStack;
+    vector<char> isBlocked;
+    // the lists 'B' of Johnson's algorithm, linked through the edges: edge (v -> w) is in the list
+    // of w while v waits for w to be unblocked; an edge is never in a list twice, so the lists take O(m)
+    vector<int> firstWaitingEdgeOf, nextWaitingEdgeOf;
+    vector<char> isWaiting;
+    // the current path, and the (node, next edge, found a cycle) frames of the DFS
+    vector<int> path;
+    struct Frame {
+        int node, edge;
+        bool foundCycle;
+    };
+    vector<Frame> frameStack;
+    vector<int> unblockStack;
+    // nodes whose blocked state or list of waiting edges changed during the current search
+    vector<int> touchedNodes;
+    // limits ('0' means no limit) and the number of cycles found so far
+    int maximumLength;
+    long long maximumCount, numberOfCycles;
+};
+
+
+// iterative Tarjan, restricted to the nodes of 'nodes' (which all belong to set 'setIndex');
+// every SCC which can contain a cycle (more than one node, or a self-loop) becomes a new set,
+// whose nodes are appended to 'components', separated by 'componentEnds'
+void splitIntoSCCs(ElementaryCycleSearch &search, const vector<int> &nodes, int setIndex,
+                   vector<int> &components, vector<int> &componentEnds) {
+    const vector<int> &firstEdgeOf = *search.firstEdgeOf, &adjacentNodes = *search.adjacentNodes;
+    vector<int> &indexOf = search.indexOf, &lowOf = search.lowOf;
+    vector<int> tarjanStack;
+    vector<pair<int, int>> callStack;
+    int index = 0;
+
+    auto isInside = [&](int node) { return search.setOf[node] == setIndex; };
+
+    for (auto sourceNode: nodes) {
+        if (indexOf[sourceNode] != -1)
+            continue;
+
+        indexOf[sourceNode] = lowOf[sourceNode] = index++;
+        search.isOnStack[sourceNode] = true;
+        tarjanStack.push_back(sourceNode);
+        callStack.emplace_back(sourceNode, firstEdgeOf[sourceNode]);
+
+        while (not callStack.empty()) {
+            int node = callStack.back().first;
+
+            if (callStack.back().second < firstEdgeOf[node + 1]) {
+                int adjacentNode = adjacentNodes[callStack.back().second++];
+                if (not isInside(adjacentNode))
+                    continue;
+
+                if (indexOf[adjacentNode] == -1) {
+                    indexOf[adjacentNode] = lowOf[adjacentNode] = index++;
+                    search.isOnStack[adjacentNode] = true;
+                    tarjanStack.push_back(adjacentNode);
+                    callStack.emplace_back(adjacentNode, firstEdgeOf[adjacentNode]);
+                } else if (search.isOnStack[adjacentNode])
+                    lowOf[node] = min(lowOf[node], indexOf[adjacentNode]);
+                continue;
+            }
+
+            callStack.pop_back();
+            if (not callStack.empty())
+                lowOf[callStack.back().first] = min(lowOf[callStack.back().first], lowOf[node]);
+
+            if (indexOf[node] != lowOf[node])
+                continue;
+
+            int start = (int) components.size();
+            while (true) {
+                int member = tarjanStack.back();
+                tarjanStack.pop_back();
+                search.isOnStack[member] = false;
+                components.push_back(member);
+                if (member == node)
+                    break;
+            }
+
+            bool hasSelfLoop = false;
+            if ((int) components.size() - start == 1)
+                for (int edge = firstEdgeOf[node]; edge < firstEdgeOf[node + 1]; edge++)
+                    hasSelfLoop |= adjacentNodes[edge] == node;
+
+            if ((int) components.size() - start == 1 and not hasSelfLoop)
+                components.pop_back();
+            else
+                componentEnds.push_back((int) components.size());
+        }
+    }
+
+    // the indices are reset for the next split, which only touches the nodes of this set
+    for (auto node: nodes)
+        indexOf[node] = -1;
+
+    // the new sets are numbered only once the whole split is done, so that
+    // 'isInside' keeps recognizing the original set until then
+    for (int component = 0, start = 0; component < (int) componentEnds.size(); component++) {
+        int newSet = search.numberOfSets++;
+        for (int i = start; i < componentEnds[component]; i++)
+            search.setOf[components[i]] = newSet;
+        start = componentEnds[component];
+    }
+}
+
+
+void unblock(ElementaryCycleSearch &search, int node) {
+    search.unblockStack.assign(1, node);
+    search.isBlocked[node] = false;
+
+    while (not search.unblockStack.empty()) {
+        int current = search.unblockStack.back();
+        search.unblockStack.pop_back();
+
+        for (int edge = search.firstWaitingEdgeOf[current]; edge != -1; edge = search.nextWaitingEdgeOf[edge]) {
+            search.isWaiting[edge] = false;
+            int waitingNode = search.edgeSourceOf[edge];
+            if (search.isBlocked[waitingNode]) {
+                search.isBlocked[waitingNode] = false;
+                search.unblockStack.push_back(waitingNode);
+            }
+        }
+        search.firstWaitingEdgeOf[current] = -1;
+    }
+}
+
+
+// every cycle through 'startNode' inside its set; returns false once the maximum count is reached,
+// and 'foundCycle' tells whether the search found a cycle (or was cut short by the maximum length)
+template<typename Callback>
+bool findCyclesThrough(ElementaryCycleSearch &search, int startNode, Callback &&callback, bool &foundCycle) {
+    const vector<int> &firstEdgeOf = *search.firstEdgeOf, &adjacentNodes = *search.adjacentNodes;
+    int setIndex = search.setOf[startNode];
+
+    search.isBlocked[startNode] = true;
+    search.touchedNodes.assign(1, startNode);
+    search.path.assign(1, startNode);
+    search.frameStack.assign(1, {startNode, firstEdgeOf[startNode], false});
+
+    while (not search.frameStack.empty()) {
+        auto &frame = search.frameStack.back();
+        int node = frame.node;
+
+        if (frame.edge < firstEdgeOf[node + 1]) {
+            int adjacentNode = adjacentNodes[frame.edge++];
+            if (search.setOf[adjacentNode] != setIndex)
+                continue;
+
+            if (adjacentNode == startNode) {
+                frame.foundCycle = true;
+                callback(search.path);
+                if (++search.numberOfCycles == search.maximumCount)
+                    return false;
+            } else if (not search.isBlocked[adjacentNode]) {
+                if (search.maximumLength != 0 and (int) search.path.size() == search.maximumLength) {
+                    // the search is cut short here, so the node can't be proven to be a dead end
+                    frame.foundCycle = true;
+                    continue;
+                }
+
+                search.isBlocked[adjacentNode] = true;
+                search.touchedNodes.push_back(adjacentNode);
+                search.path.push_back(adjacentNode);
+                // 'frame' is invalidated by the push
+                search.frameStack.push_back({adjacentNode, firstEdgeOf[adjacentNode], false});
+            }
+            continue;
+        }
+
+        foundCycle = frame.foundCycle;
+        if (foundCycle)
+            unblock(search, node);
+        else
+            // the node stays blocked until one of its successors gets unblocked
+            for (int edge = firstEdgeOf[node]; edge < firstEdgeOf[node + 1]; edge++) {
+                int adjacentNode = adjacentNodes[edge];
+                if (search.setOf[adjacentNode] == setIndex and not search.isWaiting[edge]) {
+                    search.isWaiting[edge] = true;
+                    search.nextWaitingEdgeOf[edge] = search.firstWaitingEdgeOf[adjacentNode];
+                    search.firstWaitingEdgeOf[adjacentNode] = edge;
+                    search.touchedNodes.push_back(adjacentNode);
+                }
+            }
+
+        search.frameStack.pop_back();
+        search.path.pop_back();
+        if (not search.frameStack.empty())
+            search.frameStack.back().foundCycle |= foundCycle;
+    }
+
+    return true;
+}
+
+
+// streams every elementary cycle (as the list of its nodes) to 'callback'; a maximum length and a
+// maximum count may be given ('0' for no limit); returns the number of cycles found
+template<typename Callback>
+long long enumerateElementaryCycles(int numberOfNodes, const vector<int> &firstEdgeOf,
+                                    const vector<int> &adjacentNodes, int maximumLength, long long maximumCount,
+                                    Callback &&callback) {
+    ElementaryCycleSearch search;
+    search.numberOfNodes = numberOfNodes;
+    search.firstEdgeOf = &firstEdgeOf;
+    search.adjacentNodes = &adjacentNodes;
+    search.maximumLength = maximumLength;
+    search.maximumCount = maximumCount;
+    search.numberOfCycles = 0;
+
+    int numberOfEdges = (int) adjacentNodes.size();
+    search.edgeSourceOf.resize(numberOfEdges);
+    for (int node = 0; node < numberOfNodes; node++)
+        for (int edge = firstEdgeOf[node]; edge < firstEdgeOf[node + 1]; edge++)
+            search.edgeSourceOf[edge] = node;
+
+    search.setOf.assign(numberOfNodes, 0);
+    search.numberOfSets = 1;
+    search.indexOf.assign(numberOfNodes, -1);
+    search.lowOf.resize(numberOfNodes);
+    search.isOnStack.assign(numberOfNodes, false);
+    search.isBlocked.assign(numberOfNodes, false);
+    search.firstWaitingEdgeOf.assign(numberOfNodes, -1);
+    search.nextWaitingEdgeOf.assign(numberOfEdges, -1);
+    search.isWaiting.assign(numberOfEdges, false);
+
+    // the sets left to search, stored back to back (they are disjoint, so they never take more than n)
+    vector<int> pendingNodes, pendingEnds, allNodes(numberOfNodes);
+    iota(allNodes.begin(), allNodes.end(), 0);
+    splitIntoSCCs(search, allNodes, 0, pendingNodes, pendingEnds);
+    vector<int>().swap(allNodes);
+
+    vector<int> nodes, components, componentEnds;
+    while (not pendingEnds.empty()) {
+        pendingEnds.pop_back();
+        int start = pendingEnds.empty() ? 0 : pendingEnds.back();
+        nodes.assign(pendingNodes.begin() + start, pendingNodes.end());
+        pendingNodes.resize(start);
+        sort(nodes.begin(), nodes.end());
+
+        // the nodes of the set are taken as start nodes in increasing order, and every cycle through
+        // the start node is found before removing it; what is left of the set is split into SCCs again
+        // as soon as a search finds nothing (the set is no longer strongly connected, and the following
+        // searches could keep walking its leftover paths for nothing), or once half of it is gone;
+        // while the searches keep finding cycles, they pay for not splitting after every start node
+        int setIndex = search.setOf[nodes[0]], removedNodes = 0;
+        bool isCountReached = false, foundCycle = true;
+
+        while (removedNodes < (int) nodes.size()) {
+            int startNode = nodes[removedNodes];
+            if (not findCyclesThrough(search, startNode, callback, foundCycle)) {
+                isCountReached = true;
+                break;
+            }
+
+            // the blocked state only concerns the search which just ended
+            for (auto node: search.touchedNodes) {
+                search.isBlocked[node] = false;
+                for (int edge = search.firstWaitingEdgeOf[node]; edge != -1; edge = search.nextWaitingEdgeOf[edge])
+                    search.isWaiting[edge] = false;
+                search.firstWaitingEdgeOf[node] = -1;
+            }
+
+            search.setOf[startNode] = -1;
+            removedNodes++;
+
+            if (not foundCycle or 2 * removedNodes >= (int) nodes.size())
+                break;
+        }
+
+        if (isCountReached)
+            break;
+
+        nodes.erase(nodes.begin(), nodes.begin() + removedNodes);
+
+        components.clear();
+        componentEnds.clear();
+        splitIntoSCCs(search, nodes, setIndex, components, componentEnds);
+        for (int component = 0, componentStart = 0; component < (int) componentEnds.size(); component++) {
+            pendingNodes.insert(pendingNodes.end(), components.begin() + componentStart,
+                                components.begin() + componentEnds[component]);
+            pendingEnds.push_back((int) pendingNodes.size());
+            componentStart = componentEnds[component];
+        }
+
+        // nodes left outside every new set can't lie on any more cycles
+        for (auto node: nodes)
+            if (search.setOf[node] == setIndex)
+                search.setOf[node] = -1;
+    }
+
+    return search.numberOfCycles;
+}
+
+
+int main() {
+    int numberOfNodes, numberOfEdges;
+    ifstream input;
+
+    // number of nodes and edges, followed by the edges and, optionally,
+    // the maximum length and the maximum count of the cycles ('0' for no limit)
+    input.open("cycles.in");
+
+    input >> numberOfNodes >> numberOfEdges;
+    vector<int> outNodes(numberOfEdges), inNodes(numberOfEdges);
+
+    for (int i = 0; i < numberOfEdges; i++) {
+        input >> outNodes[i] >> inNodes[i];
+        outNodes[i]--;
+        inNodes[i]--;
+    }
+
+    int maximumLength = 0;
+    long long maximumCount = 0;
+    input >> maximumLength >> maximumCount;
+
+    input.close();
+
+    vector<int> firstEdgeOf, adjacentNodes;
+    buildCompressedAdjacencyList(numberOfNodes, outNodes, inNodes, firstEdgeOf, adjacentNodes);
+
+    vector<int>().swap(outNodes);
+    vector<int>().swap(inNodes);
+
+    ofstream output;
+    output.open("cycles.out");
+
+    // every cycle on its own line, starting at its smallest node
+    enumerateElementaryCycles(numberOfNodes, firstEdgeOf, adjacentNodes, maximumLength, maximumCount,
+                              [&](const vector<int> &cycle) {
+                                  for (auto node: cycle)
+                                      output << node + 1 << ' ';
+                                  output << '\n';
+                              });
+
+    output.close();
+
+    return 0;
+}
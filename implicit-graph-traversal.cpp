@@ -0,0 +1,242 @@
+// BFS: O(m+n), Dijkstra: O(m*log(n)) - same complexities as bfs.cpp and dijkstra.cpp,
+// but the graph is never materialized: adjacent nodes are generated on the fly,
+// so the only memory used is that of the per-node 'parentOf' and 'distance' arrays
+// (plus the obstacle bitmap of the grids, a single bit per cell)
+#include <bits/stdc++.h>
+
+using namespace std;
+
+
+// The traversals below are templates over any type which describes a graph through:
+// - 'int numberOfNodes() const'
+// - 'template<typename Visit> void forEachNeighbour(int node, Visit &&visit) const',
+// which calls 'visit(adjacentNode, weight)' for every edge leaving 'node'
+// Since the neighbour enumeration is resolved at compile time, the call to 'visit'
+// gets inlined in the traversal loop, just like iterating over an adjacency list.
+#if __cpp_concepts >= 201907L
+template<typename Graph>
+concept ImplicitGraph = requires(const Graph &graph, int node) {
+    { graph.numberOfNodes() } -> convertible_to<int>;
+    graph.forEachNeighbour(node, [](int, int) {});
+};
+#define IMPLICIT_GRAPH ImplicitGraph
+#else
+#define IMPLICIT_GRAPH typename
+#endif
+
+
+// node ids are 'int's, as in every other file (the per-node arrays of a larger grid wouldn't fit in memory
+// anyway), so the grids below may hold at most INT_MAX cells, which has to be checked before building them
+bool fitsInNodeIds(long long numberOfCells) {
+    return numberOfCells <= INT_MAX;
+}
+
+
+// 2D grid, in which every free cell is connected to its (at most 4) free
+// horizontal and vertical neighbours; cell (x, y) is node 'y * width + x'
+struct GridGraph2D {
+    int width, height;
+    // one bit per cell, set for the cells which are blocked
+    vector<uint64_t> obstacles;
+
+    GridGraph2D(int width, int height) : width(width), height(height),
+                                         obstacles(((long long) width * height + 63) / 64, 0) {}
+
+    void setObstacle(int node) {
+        obstacles[node >> 6] |= 1ULL << (node & 63);
+    }
+
+    bool isFree(int node) const {
+        return not (obstacles[node >> 6] >> (node & 63) & 1);
+    }
+
+    int numberOfNodes() const {
+        return (int) ((long long) width * height);
+    }
+
+    template<typename Visit>
+    void forEachNeighbour(int node, Visit &&visit) const {
+        int x = node % width, y = node / width;
+
+        if (x > 0 and isFree(node - 1))
+            visit(node - 1, 1);
+        if (x + 1 < width and isFree(node + 1))
+            visit(node + 1, 1);
+        if (y > 0 and isFree(node - width))
+            visit(node - width, 1);
+        if (y + 1 < height and isFree(node + width))
+            visit(node + width, 1);
+    }
+};
+
+
+// 3D grid, with (at most 6) neighbours per cell; cell (x, y, z) is node '(z * height + y) * width + x'
+struct GridGraph3D {
+    int width, height, depth;
+    vector<uint64_t> obstacles;
+
+    GridGraph3D(int width, int height, int depth) : width(width), height(height), depth(depth),
+                                                    obstacles(((long long) width * height * depth + 63) / 64, 0) {}
+
+    void setObstacle(int node) {
+        obstacles[node >> 6] |= 1ULL << (node & 63);
+    }
+
+    bool isFree(int node) const {
+        return not (obstacles[node >> 6] >> (node & 63) & 1);
+    }
+
+    int numberOfNodes() const {
+        return (int) ((long long) width * height * depth);
+    }
+
+    template<typename Visit>
+    void forEachNeighbour(int node, Visit &&visit) const {
+        int layerSize = width * height;
+        int x = node % width, y = node / width % height, z = node / layerSize;
+
+        if (x > 0 and isFree(node - 1))
+            visit(node - 1, 1);
+        if (x + 1 < width and isFree(node + 1))
+            visit(node + 1, 1);
+        if (y > 0 and isFree(node - width))
+            visit(node - width, 1);
+        if (y + 1 < height and isFree(node + width))
+            visit(node + width, 1);
+        if (z > 0 and isFree(node - layerSize))
+            visit(node - layerSize, 1);
+        if (z + 1 < depth and isFree(node + layerSize))
+            visit(node + layerSize, 1);
+    }
+};
+
+
+// adapter for the explicit, weighted adjacency lists used throughout the other
+// files, so that the same traversals can run over materialized graphs as well
+struct AdjacencyListGraph {
+    const vector<vector<pair<int, int>>> &adjacencyList;
+
+    int numberOfNodes() const {
+        return (int) adjacencyList.size();
+    }
+
+    template<typename Visit>
+    void forEachNeighbour(int node, Visit &&visit) const {
+        for (auto &adjacentNode: adjacencyList[node])
+            visit(adjacentNode.first, adjacentNode.second);
+    }
+};
+
+
+// BFS over an implicit graph (edge weights are ignored);
+// a '-1' distance doubles as the 'isVisited' array
+template<IMPLICIT_GRAPH Graph>
+void implicitBFS(const Graph &graph, int sourceNode, vector<int> &parentOf, vector<int> &distanceFromSource) {
+    parentOf.assign(graph.numberOfNodes(), -1);
+    distanceFromSource.assign(graph.numberOfNodes(), -1);
+
+    queue<int> q;
+
+    distanceFromSource[sourceNode] = 0;
+    q.push(sourceNode);
+
+    int currentNode;
+    while (not q.empty()) {
+        currentNode = q.front();
+        q.pop();
+
+        graph.forEachNeighbour(currentNode, [&](int adjacentNode, int) {
+            if (distanceFromSource[adjacentNode] == -1) {
+                parentOf[adjacentNode] = currentNode;
+                distanceFromSource[adjacentNode] = distanceFromSource[currentNode] + 1;
+                q.push(adjacentNode);
+            }
+        });
+    }
+}
+
+
+// Dijkstra's Shortest Path Algorithm over an implicit graph - Priority Queue version;
+// nodes are settled the moment they are popped with their final distance, which is
+// checked by comparing the popped distance with the stored one (instead of keeping
+// an 'isVisited' array); the search halts once 'endNode' is settled, if one is given
+template<IMPLICIT_GRAPH Graph>
+void implicitDijkstra(const Graph &graph, int sourceNode, vector<int> &parentOf, vector<int> &distanceTo,
+                      int endNode = -1) {
+    parentOf.assign(graph.numberOfNodes(), -1);
+    distanceTo.assign(graph.numberOfNodes(), INT_MAX);
+
+    // min heap of (distance, node) pairs
+    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<>> priorityQueue;
+
+    distanceTo[sourceNode] = 0;
+    priorityQueue.push({0, sourceNode});
+
+    int currentNode, currentDistance;
+    while (not priorityQueue.empty()) {
+        currentDistance = priorityQueue.top().first;
+        currentNode = priorityQueue.top().second;
+        priorityQueue.pop();
+
+        // outdated pair, pushed before the node's distance got shorter
+        if (currentDistance != distanceTo[currentNode])
+            continue;
+
+        if (currentNode == endNode)
+            break;
+
+        graph.forEachNeighbour(currentNode, [&](int adjacentNode, int weight) {
+            if (currentDistance + weight < distanceTo[adjacentNode]) {
+                parentOf[adjacentNode] = currentNode;
+                distanceTo[adjacentNode] = currentDistance + weight;
+                priorityQueue.push({distanceTo[adjacentNode], adjacentNode});
+            }
+        });
+    }
+}
+
+
+int main() {
+    ifstream input("grid.in");
+
+    // grid dimensions, followed by 'height' rows of 'width' cells,
+    // '#' marking obstacles, and the coordinates of the start and end cells
+    int width, height;
+    input >> width >> height;
+
+    if (not fitsInNodeIds((long long) width * height)) {
+        cerr << "the grid has more than " << INT_MAX << " cells\n";
+        return 1;
+    }
+
+    GridGraph2D grid(width, height);
+    string row;
+    for (int y = 0; y < height; y++) {
+        input >> row;
+        for (int x = 0; x < width; x++)
+            if (row[x] == '#')
+                grid.setObstacle(y * width + x);
+    }
+
+    int startX, startY, endX, endY;
+    input >> startX >> startY >> endX >> endY;
+
+    input.close();
+
+    int startNode = (startY - 1) * width + startX - 1, endNode = (endY - 1) * width + endX - 1;
+
+    vector<int> parentOf, distances;
+    implicitBFS(grid, startNode, parentOf, distances);
+
+    ofstream output("grid.out");
+    output << distances[endNode] << '\n';
+
+    // display the path from the end cell back to the start cell
+    if (distances[endNode] != -1)
+        for (int node = endNode; node != -1; node = parentOf[node])
+            output << node % width + 1 << ' ' << node / width + 1 << '\n';
+
+    output.close();
+
+    return 0;
+}
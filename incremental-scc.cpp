@@ -0,0 +1,223 @@
+// Incremental SCCs under edge insertions, based on Pearce and Kelly's dynamic
+// topological sorting algorithm, applied to the condensation of the graph:
+// - an edge which agrees with the current topological order of the SCCs costs O(1)
+// - otherwise, only the SCCs placed between the edge's endpoints in the topological
+// order (the 'affected region') are searched and reordered; if the edge closes a
+// cycle, the SCCs lying on it are merged in the same pass
+// Every search is bounded by the affected region, so an insertion costs
+// O(size of the region * log) instead of the O(m+n) of a full recomputation.
+#include <bits/stdc++.h>
+
+using namespace std;
+
+
+struct IncrementalSCC {
+    int numberOfNodes, numberOfSCCs;
+    // disjoint sets of nodes, one for every SCC; the root of a set
+    // (its 'representative') stands for the whole SCC
+    vector<int> parentOf, sizeOf;
+    // position of every SCC in the topological order of the condensation;
+    // positions only have to be increasing along edges, so gaps are allowed
+    vector<int> positionOf;
+    // edges leaving and entering every SCC, stored as the original endpoints
+    // (edges inside an SCC are left in the lists, but skipped by the searches)
+    vector<vector<int>> outNodesOf, inNodesOf;
+    // marks of the last insertion which reached an SCC during a search
+    vector<int> forwardMark, backwardMark;
+    int currentInsertion;
+};
+
+
+void initializeIncrementalSCC(IncrementalSCC &scc, int numberOfNodes) {
+    scc.numberOfNodes = numberOfNodes;
+    scc.numberOfSCCs = numberOfNodes;
+    scc.parentOf.assign(numberOfNodes, -1);
+    scc.sizeOf.assign(numberOfNodes, 1);
+    scc.positionOf.resize(numberOfNodes);
+    scc.outNodesOf.assign(numberOfNodes, vector<int>());
+    scc.inNodesOf.assign(numberOfNodes, vector<int>());
+    scc.forwardMark.assign(numberOfNodes, 0);
+    scc.backwardMark.assign(numberOfNodes, 0);
+    scc.currentInsertion = 0;
+
+    // without any edges, every order is a topological order
+    for (int node = 0; node < numberOfNodes; node++)
+        scc.positionOf[node] = node;
+}
+
+
+// iterative find, with path compression
+int findSCC(IncrementalSCC &scc, int node) {
+    int root = node;
+    while (scc.parentOf[root] != -1)
+        root = scc.parentOf[root];
+
+    while (node != root) {
+        int next = scc.parentOf[node];
+        scc.parentOf[node] = root;
+        node = next;
+    }
+
+    return root;
+}
+
+
+// collects the SCCs reachable from 'start' (forwards or backwards), without leaving the given range of positions
+void searchAffectedRegion(IncrementalSCC &scc, int start, bool isForward, int lowestPosition, int highestPosition,
+                          vector<int> &reached) {
+    vector<int> &mark = isForward ? scc.forwardMark : scc.backwardMark;
+    vector<int> stack = {start};
+    mark[start] = scc.currentInsertion;
+    reached.push_back(start);
+
+    while (not stack.empty()) {
+        int component = stack.back();
+        stack.pop_back();
+
+        for (auto node: isForward ? scc.outNodesOf[component] : scc.inNodesOf[component]) {
+            int adjacentComponent = findSCC(scc, node);
+
+            if (mark[adjacentComponent] != scc.currentInsertion and
+                lowestPosition <= scc.positionOf[adjacentComponent] and
+                scc.positionOf[adjacentComponent] <= highestPosition) {
+                mark[adjacentComponent] = scc.currentInsertion;
+                reached.push_back(adjacentComponent);
+                stack.push_back(adjacentComponent);
+            }
+        }
+    }
+}
+
+
+// merges all the given SCCs into one, returning its representative
+int mergeSCCs(IncrementalSCC &scc, const vector<int> &components) {
+    // the largest SCC absorbs the others, so that edge lists are moved as little as possible
+    int root = components[0];
+    for (auto component: components)
+        if (scc.sizeOf[component] > scc.sizeOf[root])
+            root = component;
+
+    for (auto component: components) {
+        if (component == root)
+            continue;
+
+        scc.parentOf[component] = root;
+        scc.sizeOf[root] += scc.sizeOf[component];
+
+        scc.outNodesOf[root].insert(scc.outNodesOf[root].end(), scc.outNodesOf[component].begin(),
+                                    scc.outNodesOf[component].end());
+        scc.inNodesOf[root].insert(scc.inNodesOf[root].end(), scc.inNodesOf[component].begin(),
+                                   scc.inNodesOf[component].end());
+        vector<int>().swap(scc.outNodesOf[component]);
+        vector<int>().swap(scc.inNodesOf[component]);
+    }
+
+    scc.numberOfSCCs -= (int) components.size() - 1;
+    return root;
+}
+
+
+// inserts the edge 'outNode' -> 'inNode'; returns the representatives the SCCs had
+// before being merged into one (empty, if the edge didn't close any cycle)
+vector<int> insertEdge(IncrementalSCC &scc, int outNode, int inNode) {
+    int outComponent = findSCC(scc, outNode), inComponent = findSCC(scc, inNode);
+
+    // edges inside an SCC don't change the condensation
+    if (outComponent == inComponent)
+        return {};
+
+    scc.outNodesOf[outComponent].push_back(inNode);
+    scc.inNodesOf[inComponent].push_back(outNode);
+
+    // the edge agrees with the current order
+    int lowestPosition = scc.positionOf[inComponent], highestPosition = scc.positionOf[outComponent];
+    if (highestPosition < lowestPosition)
+        return {};
+
+    scc.currentInsertion++;
+
+    // only SCCs placed between the two endpoints may have to be moved:
+    // those reachable from the in-node's SCC have to end up after those
+    // that can reach the out-node's SCC
+    vector<int> forwardRegion, backwardRegion;
+    searchAffectedRegion(scc, inComponent, true, lowestPosition, highestPosition, forwardRegion);
+    searchAffectedRegion(scc, outComponent, false, lowestPosition, highestPosition, backwardRegion);
+
+    // every position in the region is reused, in increasing order
+    vector<int> freePositions;
+    for (auto component: forwardRegion)
+        freePositions.push_back(scc.positionOf[component]);
+    for (auto component: backwardRegion)
+        if (scc.forwardMark[component] != scc.currentInsertion)
+            freePositions.push_back(scc.positionOf[component]);
+    sort(freePositions.begin(), freePositions.end());
+
+    auto byPosition = [&](int first, int second) { return scc.positionOf[first] < scc.positionOf[second]; };
+
+    // SCCs reached by both searches lie on a cycle closed by the new edge
+    vector<int> cycle, onlyForward, onlyBackward;
+    for (auto component: forwardRegion)
+        if (scc.backwardMark[component] == scc.currentInsertion)
+            cycle.push_back(component);
+        else
+            onlyForward.push_back(component);
+    for (auto component: backwardRegion)
+        if (scc.forwardMark[component] != scc.currentInsertion)
+            onlyBackward.push_back(component);
+
+    sort(onlyForward.begin(), onlyForward.end(), byPosition);
+    sort(onlyBackward.begin(), onlyBackward.end(), byPosition);
+
+    // new order of the region: the SCCs which can only reach the out-node's SCC take the
+    // lowest positions, while those only reachable from the in-node's SCC take the highest
+    // ones, with the merged SCC (if any) right before them; this way, the former can only
+    // move to lower positions and the latter to higher ones, so edges shared with SCCs
+    // outside the region (which aren't moved at all) still agree with the order
+    int nextPosition = 0;
+    for (auto component: onlyBackward)
+        scc.positionOf[component] = freePositions[nextPosition++];
+
+    nextPosition = (int) freePositions.size() - (int) onlyForward.size();
+    for (auto component: onlyForward)
+        scc.positionOf[component] = freePositions[nextPosition++];
+
+    if (not cycle.empty()) {
+        int mergedComponent = mergeSCCs(scc, cycle);
+        scc.positionOf[mergedComponent] = freePositions[freePositions.size() - onlyForward.size() - 1];
+    }
+
+    return cycle;
+}
+
+
+int main() {
+    int numberOfNodes, numberOfEdges, outNode, inNode;
+    ifstream input;
+
+    input.open("ctc.in");
+    input >> numberOfNodes >> numberOfEdges;
+
+    IncrementalSCC scc;
+    initializeIncrementalSCC(scc, numberOfNodes);
+
+    ofstream output;
+    output.open("ctc.out");
+
+    // after every insertion: the number of SCCs, followed by
+    // the representatives of the SCCs which got merged, if any
+    for (int i = 0; i < numberOfEdges; i++) {
+        input >> outNode >> inNode;
+
+        vector<int> mergedSCCs = insertEdge(scc, outNode - 1, inNode - 1);
+
+        output << scc.numberOfSCCs;
+        for (auto component: mergedSCCs)
+            output << ' ' << component + 1;
+        output << '\n';
+    }
+
+    input.close();
+    output.close();
+
+    return 0;
+}
@@ -0,0 +1,327 @@
+// k-core decomposition of undirected graphs
+// - Batagelj and Zaversnik: O(n + m) - nodes are kept sorted by their current degree in
+// an array split into buckets (one per degree), and repeatedly removing the node of the
+// smallest degree only moves each of its neighbors one bucket down, in O(1)
+// - parallel peeling: O(n*k + m) work, k being the largest core number - all the nodes with
+// degree k are removed at once, decrementing the degrees of their neighbors atomically;
+// neighbors dropping to degree k are removed in the same round, until none are left
+//
+//      The k-core is the largest subgraph whose nodes all have degree at least k; the core
+// number of a node is the largest k for which it belongs to the k-core, and the order in
+// which the nodes are removed is a degeneracy order (every node has at most 'degeneracy'
+// neighbors placed after it).
+#include <bits/stdc++.h>
+
+using namespace std;
+
+
+// buffered reader for large inputs: the file is read in blocks of 64KB,
+// instead of parsing one token at a time through 'ifstream'
+struct InputReader {
+    FILE *file;
+    char buffer[1 << 16];
+    int size = 0, position = 0;
+
+    explicit InputReader(const char *fileName) : file(fopen(fileName, "r")) {}
+
+    ~InputReader() {
+        if (file)
+            fclose(file);
+    }
+
+    int nextCharacter() {
+        if (position == size) {
+            size = (int) fread(buffer, 1, sizeof(buffer), file);
+            position = 0;
+            if (size <= 0)
+                return EOF;
+        }
+        return (unsigned char) buffer[position++];
+    }
+
+    // returns false once the end of the file is reached
+    template<typename Integer>
+    bool readInt(Integer &value) {
+        int character = nextCharacter();
+        while (character != EOF and character != '-' and not isdigit(character))
+            character = nextCharacter();
+        if (character == EOF)
+            return false;
+
+        bool isNegative = character == '-';
+        if (isNegative)
+            character = nextCharacter();
+
+        value = 0;
+        for (; character != EOF and isdigit(character); character = nextCharacter())
+            value = value * 10 + (character - '0');
+        if (isNegative)
+            value = -value;
+
+        return true;
+    }
+};
+
+
+// splits [begin, end) into chunks which are handed out to the threads on demand;
+// 'function(i, threadIndex)' is called for every index, 'threadIndex' being the index of the
+// thread running it, which is useful for accessing per-thread buffers
+template<typename Function>
+void parallelFor(int begin, int end, int numberOfThreads, Function &&function) {
+    const int chunkSize = 1024;
+
+    // not worth starting any threads
+    if (numberOfThreads == 1 or end - begin <= chunkSize) {
+        for (int i = begin; i < end; i++)
+            function(i, 0);
+        return;
+    }
+
+    atomic<int> nextChunk(begin);
+    auto work = [&](int threadIndex) {
+        int chunkBegin;
+        while ((chunkBegin = nextChunk.fetch_add(chunkSize)) < end)
+            for (int i = chunkBegin; i < min(end, chunkBegin + chunkSize); i++)
+                function(i, threadIndex);
+    };
+
+    vector<thread> threads;
+    for (int threadIndex = 1; threadIndex < numberOfThreads; threadIndex++)
+        threads.emplace_back(work, threadIndex);
+    work(0);
+
+    for (auto &worker: threads)
+        worker.join();
+}
+
+
+// compressed adjacency list of an undirected graph, with 64-bit offsets so that billions of
+// edges fit: the neighbors of 'node' are 'adjacentNodes[firstEdgeOf[node]]', ...,
+// 'adjacentNodes[firstEdgeOf[node + 1] - 1]'; self-loops are left out
+void buildCompressedAdjacencyList(int numberOfNodes, const vector<int> &firstNodes, const vector<int> &secondNodes,
+                                  vector<long long> &firstEdgeOf, vector<int> &adjacentNodes) {
+    long long numberOfEdges = (long long) firstNodes.size();
+    firstEdgeOf.assign(numberOfNodes + 1, 0);
+
+    for (long long edge = 0; edge < numberOfEdges; edge++)
+        if (firstNodes[edge] != secondNodes[edge]) {
+            firstEdgeOf[firstNodes[edge] + 1]++;
+            firstEdgeOf[secondNodes[edge] + 1]++;
+        }
+    for (int node = 0; node < numberOfNodes; node++)
+        firstEdgeOf[node + 1] += firstEdgeOf[node];
+
+    adjacentNodes.resize(firstEdgeOf[numberOfNodes]);
+    vector<long long> nextPosition(firstEdgeOf.begin(), firstEdgeOf.end() - 1);
+    for (long long edge = 0; edge < numberOfEdges; edge++)
+        if (firstNodes[edge] != secondNodes[edge]) {
+            adjacentNodes[nextPosition[firstNodes[edge]]++] = secondNodes[edge];
+            adjacentNodes[nextPosition[secondNodes[edge]]++] = firstNodes[edge];
+        }
+}
+
+
+// Batagelj and Zaversnik's algorithm: returns the degeneracy, filling in the
+// core number of every node and the degeneracy order
+int decomposeIntoCores(int numberOfNodes, const vector<long long> &firstEdgeOf, const vector<int> &adjacentNodes,
+                       vector<int> &coreOf, vector<int> &degeneracyOrder) {
+    // the current degree of every node ends up being its core number
+    vector<int> &degreeOf = coreOf;
+    degreeOf.resize(numberOfNodes);
+
+    int maximumDegree = 0;
+    for (int node = 0; node < numberOfNodes; node++) {
+        degreeOf[node] = (int) (firstEdgeOf[node + 1] - firstEdgeOf[node]);
+        maximumDegree = max(maximumDegree, degreeOf[node]);
+    }
+
+    // 'degeneracyOrder' holds the nodes sorted by their current degree (counting sort);
+    // the bucket of degree d starts at 'bucketStartOf[d]', and 'positionOf' is the inverse
+    vector<int> bucketStartOf(maximumDegree + 1, 0), positionOf(numberOfNodes);
+    degeneracyOrder.resize(numberOfNodes);
+
+    for (int node = 0; node < numberOfNodes; node++)
+        bucketStartOf[degreeOf[node]]++;
+    for (int degree = 0, start = 0; degree <= maximumDegree; degree++) {
+        int bucketSize = bucketStartOf[degree];
+        bucketStartOf[degree] = start;
+        start += bucketSize;
+    }
+    for (int node = 0; node < numberOfNodes; node++) {
+        positionOf[node] = bucketStartOf[degreeOf[node]]++;
+        degeneracyOrder[positionOf[node]] = node;
+    }
+    // the starts were shifted while placing the nodes
+    for (int degree = maximumDegree; degree > 0; degree--)
+        bucketStartOf[degree] = bucketStartOf[degree - 1];
+    bucketStartOf[0] = 0;
+
+    int degeneracy = 0;
+    for (int i = 0; i < numberOfNodes; i++) {
+        // the node of the smallest degree among the remaining ones is removed
+        int node = degeneracyOrder[i];
+        degeneracy = max(degeneracy, degreeOf[node]);
+
+        for (long long edge = firstEdgeOf[node]; edge < firstEdgeOf[node + 1]; edge++) {
+            int adjacentNode = adjacentNodes[edge];
+            if (degreeOf[adjacentNode] <= degreeOf[node])
+                continue;
+
+            // the neighbor is swapped with the first node of its bucket,
+            // which then starts one position later, so the neighbor moves one bucket down
+            int degree = degreeOf[adjacentNode];
+            int firstPosition = bucketStartOf[degree], firstNode = degeneracyOrder[firstPosition];
+            if (firstNode != adjacentNode) {
+                swap(degeneracyOrder[positionOf[adjacentNode]], degeneracyOrder[firstPosition]);
+                positionOf[firstNode] = positionOf[adjacentNode];
+                positionOf[adjacentNode] = firstPosition;
+            }
+
+            bucketStartOf[degree]++;
+            degreeOf[adjacentNode]--;
+        }
+    }
+
+    return degeneracy;
+}
+
+
+// parallel peeling: returns the degeneracy, filling in the core number of every node and a
+// degeneracy order (the order of the removals; the order inside a round depends on the scheduling)
+int decomposeIntoCoresInParallel(int numberOfNodes, int numberOfThreads, const vector<long long> &firstEdgeOf,
+                                 const vector<int> &adjacentNodes, vector<int> &coreOf,
+                                 vector<int> &degeneracyOrder) {
+    vector<atomic<int>> degreeOf(numberOfNodes);
+    parallelFor(0, numberOfNodes, numberOfThreads, [&](int node, int /*threadIndex*/) {
+        degreeOf[node].store((int) (firstEdgeOf[node + 1] - firstEdgeOf[node]), memory_order_relaxed);
+    });
+
+    coreOf.assign(numberOfNodes, -1);
+    degeneracyOrder.clear();
+    degeneracyOrder.reserve(numberOfNodes);
+
+    // nodes which haven't been removed yet, and per-thread buffers of the nodes found by every pass
+    vector<int> remainingNodes(numberOfNodes), frontier;
+    iota(remainingNodes.begin(), remainingNodes.end(), 0);
+    vector<vector<int>> buffers(numberOfThreads);
+
+    auto gather = [&](vector<int> &nodes) {
+        nodes.clear();
+        for (auto &buffer: buffers) {
+            nodes.insert(nodes.end(), buffer.begin(), buffer.end());
+            buffer.clear();
+        }
+    };
+
+    int k = 0;
+    while (not remainingNodes.empty()) {
+        // the nodes whose degree already dropped to k start the round
+        parallelFor(0, (int) remainingNodes.size(), numberOfThreads, [&](int i, int threadIndex) {
+            int node = remainingNodes[i];
+            if (degreeOf[node].load(memory_order_relaxed) <= k)
+                buffers[threadIndex].push_back(node);
+        });
+        gather(frontier);
+
+        while (not frontier.empty()) {
+            for (auto node: frontier)
+                coreOf[node] = k;
+            degeneracyOrder.insert(degeneracyOrder.end(), frontier.begin(), frontier.end());
+
+            parallelFor(0, (int) frontier.size(), numberOfThreads, [&](int i, int threadIndex) {
+                int node = frontier[i];
+
+                for (long long edge = firstEdgeOf[node]; edge < firstEdgeOf[node + 1]; edge++) {
+                    int adjacentNode = adjacentNodes[edge];
+                    if (degreeOf[adjacentNode].load(memory_order_relaxed) <= k)
+                        continue;
+
+                    // exactly one decrement takes the neighbor from k + 1 to k, and that thread
+                    // adds it to the next pass; decrements which went too far are undone
+                    int previousDegree = degreeOf[adjacentNode].fetch_sub(1, memory_order_relaxed);
+                    if (previousDegree == k + 1)
+                        buffers[threadIndex].push_back(adjacentNode);
+                    else if (previousDegree <= k)
+                        degreeOf[adjacentNode].fetch_add(1, memory_order_relaxed);
+                }
+            });
+            gather(frontier);
+        }
+
+        // only the nodes which are still left are scanned in the next round
+        parallelFor(0, (int) remainingNodes.size(), numberOfThreads, [&](int i, int threadIndex) {
+            if (coreOf[remainingNodes[i]] == -1)
+                buffers[threadIndex].push_back(remainingNodes[i]);
+        });
+        gather(remainingNodes);
+
+        k++;
+    }
+
+    return degeneracyOrder.empty() ? 0 : *max_element(coreOf.begin(), coreOf.end());
+}
+
+
+// the number of threads may be given as the first argument (all cores by default);
+// a single thread runs the bucket ordering, more than one the parallel peeling
+int main(int argc, char **argv) {
+    int numberOfThreads = argc > 1 ? atoi(argv[1]) : (int) thread::hardware_concurrency();
+    numberOfThreads = max(numberOfThreads, 1);
+
+    // number of nodes and (undirected) edges, followed by the edges
+    InputReader input("kcore.in");
+    if (not input.file) {
+        cerr << "can't open kcore.in\n";
+        return 1;
+    }
+
+    int numberOfNodes = 0;
+    long long numberOfEdges = 0;
+    input.readInt(numberOfNodes);
+    input.readInt(numberOfEdges);
+
+    vector<int> firstNodes(numberOfEdges), secondNodes(numberOfEdges);
+    for (long long i = 0; i < numberOfEdges; i++) {
+        input.readInt(firstNodes[i]);
+        input.readInt(secondNodes[i]);
+        firstNodes[i]--;
+        secondNodes[i]--;
+    }
+
+    vector<long long> firstEdgeOf;
+    vector<int> adjacentNodes;
+    buildCompressedAdjacencyList(numberOfNodes, firstNodes, secondNodes, firstEdgeOf, adjacentNodes);
+
+    vector<int>().swap(firstNodes);
+    vector<int>().swap(secondNodes);
+
+    vector<int> coreOf, degeneracyOrder;
+    int degeneracy;
+    auto start = chrono::steady_clock::now();
+    if (numberOfThreads == 1)
+        degeneracy = decomposeIntoCores(numberOfNodes, firstEdgeOf, adjacentNodes, coreOf, degeneracyOrder);
+    else
+        degeneracy = decomposeIntoCoresInParallel(numberOfNodes, numberOfThreads, firstEdgeOf, adjacentNodes, coreOf,
+                                                  degeneracyOrder);
+    auto finish = chrono::steady_clock::now();
+
+    cerr << (numberOfThreads == 1 ? "bucket ordering" : "parallel peeling") << ", " << numberOfThreads
+         << (numberOfThreads == 1 ? " thread: " : " threads: ")
+         << chrono::duration_cast<chrono::milliseconds>(finish - start).count() << " ms\n";
+
+    ofstream output;
+    output.open("kcore.out");
+
+    // the degeneracy, followed by the core number of every node and by the degeneracy order
+    output << degeneracy << '\n';
+    for (int node = 0; node < numberOfNodes; node++)
+        output << coreOf[node] << ' ';
+    output << '\n';
+    for (auto node: degeneracyOrder)
+        output << node + 1 << ' ';
+    output << '\n';
+
+    output.close();
+
+    return 0;
+}
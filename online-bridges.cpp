@@ -0,0 +1,215 @@
+// Online bridge maintenance, for undirected graphs which only grow through edge insertions
+// O(n*log(n) + m*α(n)) amortized over all insertions:
+// - an edge joining two connected components becomes a bridge; the smaller component's
+// tree is re-rooted and hung below the larger one, so every node is re-rooted O(log(n)) times
+// - an edge inside a connected component closes a cycle in the forest of 2-edge-connected
+// components; every bridge on that cycle stops being one, and the components along it are
+// collapsed into one, which is paid for by the bridges disappearing
+#include <bits/stdc++.h>
+
+using namespace std;
+
+
+struct OnlineBridges {
+    int numberOfBridges;
+    // disjoint sets of nodes: 2-edge-connected components and connected components;
+    // both are identified by their root (representative) node
+    vector<int> twoEdgeParentOf, componentParentOf, componentSizeOf;
+    // forest of 2-edge-connected components, whose edges are exactly the bridges:
+    // the parent of every component's representative (possibly outdated, so it has to
+    // be passed through 'findTwoEdgeComponent'), along with the edge leading to it
+    vector<int> treeParentOf, bridgeEdgeOf;
+    // marks of the last cycle search which reached every component
+    vector<int> lastVisitedBy;
+    int currentSearch;
+};
+
+
+void initializeOnlineBridges(OnlineBridges &graph, int numberOfNodes) {
+    graph.numberOfBridges = 0;
+    graph.twoEdgeParentOf.resize(numberOfNodes);
+    graph.componentParentOf.resize(numberOfNodes);
+    graph.componentSizeOf.assign(numberOfNodes, 1);
+    graph.treeParentOf.assign(numberOfNodes, -1);
+    graph.bridgeEdgeOf.assign(numberOfNodes, -1);
+    graph.lastVisitedBy.assign(numberOfNodes, 0);
+    graph.currentSearch = 0;
+
+    for (int node = 0; node < numberOfNodes; node++)
+        graph.twoEdgeParentOf[node] = graph.componentParentOf[node] = node;
+}
+
+
+// iterative find, with path compression
+int findRoot(vector<int> &parentOf, int node) {
+    int root = node;
+    while (parentOf[root] != root)
+        root = parentOf[root];
+
+    while (node != root) {
+        int next = parentOf[node];
+        parentOf[node] = root;
+        node = next;
+    }
+
+    return root;
+}
+
+
+int findTwoEdgeComponent(OnlineBridges &graph, int node) {
+    if (node == -1)
+        return -1;
+    return findRoot(graph.twoEdgeParentOf, node);
+}
+
+
+// the sets of connected components are defined over the representatives of the 2-edge-connected components
+int findConnectedComponent(OnlineBridges &graph, int node) {
+    return findRoot(graph.componentParentOf, findTwoEdgeComponent(graph, node));
+}
+
+
+// turns the 2-edge-connected component of 'node' into the root of its tree,
+// by reversing the tree edges on the path leading to the current root
+void makeRoot(OnlineBridges &graph, int node) {
+    node = findTwoEdgeComponent(graph, node);
+    int root = node, child = -1, childEdge = -1;
+
+    while (node != -1) {
+        int parent = findTwoEdgeComponent(graph, graph.treeParentOf[node]);
+        int parentEdge = graph.bridgeEdgeOf[node];
+
+        graph.treeParentOf[node] = child;
+        graph.bridgeEdgeOf[node] = childEdge;
+        graph.componentParentOf[node] = root;
+
+        child = node;
+        childEdge = parentEdge;
+        node = parent;
+    }
+
+    graph.componentSizeOf[root] = graph.componentSizeOf[child];
+}
+
+
+// collapses the tree path between the 2-edge-connected components of the two nodes
+// (which belong to the same tree) into their lowest common ancestor; both paths are
+// climbed one step at a time, alternately, so that the work is proportional to the
+// length of the cycle, rather than to the depth of the tree
+void collapsePath(OnlineBridges &graph, int firstNode, int secondNode) {
+    int search = ++graph.currentSearch;
+    vector<int> firstPath, secondPath;
+    int lowestCommonAncestor = -1;
+
+    while (lowestCommonAncestor == -1) {
+        if (firstNode != -1) {
+            firstNode = findTwoEdgeComponent(graph, firstNode);
+            firstPath.push_back(firstNode);
+
+            if (graph.lastVisitedBy[firstNode] == search) {
+                lowestCommonAncestor = firstNode;
+                break;
+            }
+
+            graph.lastVisitedBy[firstNode] = search;
+            firstNode = graph.treeParentOf[firstNode];
+        }
+
+        if (secondNode != -1) {
+            secondNode = findTwoEdgeComponent(graph, secondNode);
+            secondPath.push_back(secondNode);
+
+            if (graph.lastVisitedBy[secondNode] == search) {
+                lowestCommonAncestor = secondNode;
+                break;
+            }
+
+            graph.lastVisitedBy[secondNode] = search;
+            secondNode = graph.treeParentOf[secondNode];
+        }
+    }
+
+    // every component on the cycle joins the lowest common ancestor,
+    // and the bridges between them stop being bridges
+    for (auto path: {&firstPath, &secondPath})
+        for (auto component: *path) {
+            graph.twoEdgeParentOf[component] = lowestCommonAncestor;
+            if (component == lowestCommonAncestor)
+                break;
+
+            graph.numberOfBridges--;
+        }
+}
+
+
+void insertEdge(OnlineBridges &graph, int edge, int firstNode, int secondNode) {
+    firstNode = findTwoEdgeComponent(graph, firstNode);
+    secondNode = findTwoEdgeComponent(graph, secondNode);
+
+    // edges inside a 2-edge-connected component change nothing
+    if (firstNode == secondNode)
+        return;
+
+    int firstComponent = findConnectedComponent(graph, firstNode);
+    int secondComponent = findConnectedComponent(graph, secondNode);
+
+    if (firstComponent != secondComponent) {
+        // the edge is the only connection between the two components, which makes it a bridge;
+        // the smaller tree is re-rooted at the new edge's endpoint and hung below the other endpoint
+        graph.numberOfBridges++;
+
+        if (graph.componentSizeOf[firstComponent] > graph.componentSizeOf[secondComponent]) {
+            swap(firstNode, secondNode);
+            swap(firstComponent, secondComponent);
+        }
+
+        makeRoot(graph, firstNode);
+        graph.treeParentOf[firstNode] = graph.componentParentOf[firstNode] = secondNode;
+        graph.bridgeEdgeOf[firstNode] = edge;
+        graph.componentSizeOf[secondComponent] += graph.componentSizeOf[firstNode];
+    } else
+        collapsePath(graph, firstNode, secondNode);
+}
+
+
+// O(n) - indices of the edges which are currently bridges
+vector<int> getBridges(OnlineBridges &graph) {
+    vector<int> bridges;
+
+    for (int node = 0; node < (int) graph.twoEdgeParentOf.size(); node++)
+        if (findTwoEdgeComponent(graph, node) == node and graph.treeParentOf[node] != -1)
+            bridges.push_back(graph.bridgeEdgeOf[node]);
+
+    return bridges;
+}
+
+
+int main() {
+    ifstream input("graf.in");
+
+    int numberOfNodes, numberOfEdges;
+    input >> numberOfNodes >> numberOfEdges;
+
+    OnlineBridges graph;
+    initializeOnlineBridges(graph, numberOfNodes);
+
+    vector<pair<int, int>> edges(numberOfEdges);
+    for (int i = 0; i < numberOfEdges; i++) {
+        input >> edges[i].first >> edges[i].second;
+        edges[i].first--;
+        edges[i].second--;
+
+        insertEdge(graph, i, edges[i].first, edges[i].second);
+
+        // number of bridges after every insertion
+        cout << graph.numberOfBridges << '\n';
+    }
+
+    input.close();
+
+    // the bridges of the final graph
+    for (auto edge: getBridges(graph))
+        cout << edges[edge].first + 1 << ' ' << edges[edge].second + 1 << '\n';
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+// Online topological sorting, for DAGs which grow through edge insertions (Pearce and Kelly)
+// - an edge which agrees with the current order is inserted in O(1)
+// - otherwise, only the nodes placed between the edge's endpoints (the 'affected region')
+// are searched: forwards from the in-node and backwards from the out-node; reaching the
+// out-node from the in-node means that the edge would close a cycle, so it's rejected
+// before anything changes; if not, the nodes found by both searches are reordered among
+// the positions they already occupied, so nothing outside the region moves
+// An insertion costs O(size of the region * log) rather than the O(m+n) of a full rerun of Kahn's algorithm.
+#include <bits/stdc++.h>
+
+using namespace std;
+
+
+struct OnlineTopologicalOrder {
+    int numberOfNodes;
+    // position of every node in the order, and the node placed on every position
+    vector<int> positionOf, nodeAt;
+    vector<vector<int>> outNodesOf, inNodesOf;
+    // marks of the last insertion which reached a node during a search
+    vector<int> forwardMark, backwardMark;
+    int currentInsertion;
+    // reused by every insertion, so that no allocation happens once they have grown
+    vector<int> stack, forwardRegion, backwardRegion, freePositions;
+};
+
+
+void initializeOnlineTopologicalOrder(OnlineTopologicalOrder &graph, int numberOfNodes) {
+    graph.numberOfNodes = numberOfNodes;
+    graph.positionOf.resize(numberOfNodes);
+    graph.nodeAt.resize(numberOfNodes);
+    graph.outNodesOf.assign(numberOfNodes, vector<int>());
+    graph.inNodesOf.assign(numberOfNodes, vector<int>());
+    graph.forwardMark.assign(numberOfNodes, 0);
+    graph.backwardMark.assign(numberOfNodes, 0);
+    graph.currentInsertion = 0;
+
+    // without any edges, every order is a topological order
+    for (int node = 0; node < numberOfNodes; node++)
+        graph.positionOf[node] = graph.nodeAt[node] = node;
+}
+
+
+// forward search from the in-node, through the nodes placed no later than the out-node;
+// returns false as soon as the out-node is reached (the edge would close a cycle)
+bool searchForwards(OnlineTopologicalOrder &graph, int inNode, int outNode) {
+    int highestPosition = graph.positionOf[outNode];
+
+    graph.stack.assign(1, inNode);
+    graph.forwardMark[inNode] = graph.currentInsertion;
+    graph.forwardRegion.assign(1, inNode);
+
+    while (not graph.stack.empty()) {
+        int node = graph.stack.back();
+        graph.stack.pop_back();
+
+        for (auto adjacentNode: graph.outNodesOf[node]) {
+            if (adjacentNode == outNode)
+                return false;
+
+            if (graph.forwardMark[adjacentNode] != graph.currentInsertion and
+                graph.positionOf[adjacentNode] < highestPosition) {
+                graph.forwardMark[adjacentNode] = graph.currentInsertion;
+                graph.forwardRegion.push_back(adjacentNode);
+                graph.stack.push_back(adjacentNode);
+            }
+        }
+    }
+
+    return true;
+}
+
+
+// backward search from the out-node, through the nodes placed no earlier than the in-node
+void searchBackwards(OnlineTopologicalOrder &graph, int outNode, int inNode) {
+    int lowestPosition = graph.positionOf[inNode];
+
+    graph.stack.assign(1, outNode);
+    graph.backwardMark[outNode] = graph.currentInsertion;
+    graph.backwardRegion.assign(1, outNode);
+
+    while (not graph.stack.empty()) {
+        int node = graph.stack.back();
+        graph.stack.pop_back();
+
+        for (auto adjacentNode: graph.inNodesOf[node])
+            if (graph.backwardMark[adjacentNode] != graph.currentInsertion and
+                graph.positionOf[adjacentNode] > lowestPosition) {
+                graph.backwardMark[adjacentNode] = graph.currentInsertion;
+                graph.backwardRegion.push_back(adjacentNode);
+                graph.stack.push_back(adjacentNode);
+            }
+    }
+}
+
+
+// inserts the edge 'outNode' -> 'inNode', unless it would close a cycle;
+// returns whether the edge was inserted
+bool insertEdge(OnlineTopologicalOrder &graph, int outNode, int inNode) {
+    if (outNode == inNode)
+        return false;
+
+    // the edge agrees with the current order
+    if (graph.positionOf[outNode] < graph.positionOf[inNode]) {
+        graph.outNodesOf[outNode].push_back(inNode);
+        graph.inNodesOf[inNode].push_back(outNode);
+        return true;
+    }
+
+    graph.currentInsertion++;
+
+    if (not searchForwards(graph, inNode, outNode))
+        return false;
+    searchBackwards(graph, outNode, inNode);
+
+    // the two searches can't share any node, since such a node would lie on a path from the in-node
+    // to the out-node; the nodes which can reach the out-node have to be placed before those reachable
+    // from the in-node, while keeping their relative orders, and the positions they occupied are reused
+    auto byPosition = [&](int first, int second) { return graph.positionOf[first] < graph.positionOf[second]; };
+    sort(graph.forwardRegion.begin(), graph.forwardRegion.end(), byPosition);
+    sort(graph.backwardRegion.begin(), graph.backwardRegion.end(), byPosition);
+
+    graph.freePositions.clear();
+    for (auto node: graph.backwardRegion)
+        graph.freePositions.push_back(graph.positionOf[node]);
+    for (auto node: graph.forwardRegion)
+        graph.freePositions.push_back(graph.positionOf[node]);
+    // both halves are already sorted
+    inplace_merge(graph.freePositions.begin(), graph.freePositions.begin() + (int) graph.backwardRegion.size(),
+                  graph.freePositions.end());
+
+    int nextPosition = 0;
+    for (auto region: {&graph.backwardRegion, &graph.forwardRegion})
+        for (auto node: *region) {
+            graph.positionOf[node] = graph.freePositions[nextPosition++];
+            graph.nodeAt[graph.positionOf[node]] = node;
+        }
+
+    graph.outNodesOf[outNode].push_back(inNode);
+    graph.inNodesOf[inNode].push_back(outNode);
+    return true;
+}
+
+
+int main() {
+    int numberOfNodes, numberOfEdges, outNode, inNode;
+    ifstream input;
+
+    input.open("toposort.in");
+    input >> numberOfNodes >> numberOfEdges;
+
+    OnlineTopologicalOrder graph;
+    initializeOnlineTopologicalOrder(graph, numberOfNodes);
+
+    ofstream output;
+    output.open("toposort.out");
+
+    // after every insertion: '1' if the edge was inserted, '0' if it was rejected for closing a cycle
+    chrono::steady_clock::duration totalTime{};
+    for (int i = 0; i < numberOfEdges; i++) {
+        input >> outNode >> inNode;
+
+        auto start = chrono::steady_clock::now();
+        bool isInserted = insertEdge(graph, outNode - 1, inNode - 1);
+        totalTime += chrono::steady_clock::now() - start;
+
+        output << isInserted << '\n';
+    }
+
+    input.close();
+
+    // the final topological order
+    for (int position = 0; position < numberOfNodes; position++)
+        output << graph.nodeAt[position] + 1 << ' ';
+    output << '\n';
+
+    output.close();
+
+    cerr << "average insertion: "
+         << chrono::duration_cast<chrono::nanoseconds>(totalTime).count() / max(numberOfEdges, 1) << " ns\n";
+
+    return 0;
+}
@@ -0,0 +1,393 @@
+// Parallel articulation points and bridges, following Tarjan and Vishkin's algorithm:
+// - a spanning forest is built with a parallel (level-synchronous) BFS
+// - nodes are numbered in preorder, computed from the subtree sizes, level by level
+// - 'low' and 'high' (the smallest and largest preorder numbers reachable from a subtree
+// through a single non-tree edge) are aggregated bottom-up, level by level
+// - the tree edges are split into blocks by computing the connected components of an
+// auxiliary graph (whose nodes are the tree edges) with a concurrent union-find
+// Every step is O(m+n) work split among the threads, with O(depth of the BFS forest)
+// synchronization points; unlike the DFS-based critical-points.cpp and critical-edges.cpp,
+// no step depends on the order in which the others visit the graph.
+#include <bits/stdc++.h>
+
+using namespace std;
+
+
+// splits [begin, end) into chunks which are handed out to the threads on demand;
+// 'function(i, threadIndex)' is called for every index, 'threadIndex' being the index of the
+// thread running it, which is useful for accessing per-thread buffers
+template<typename Function>
+void parallelFor(int begin, int end, int numberOfThreads, Function &&function) {
+    const int chunkSize = 1024;
+
+    // not worth starting any threads
+    if (numberOfThreads == 1 or end - begin <= chunkSize) {
+        for (int i = begin; i < end; i++)
+            function(i, 0);
+        return;
+    }
+
+    atomic<int> nextChunk(begin);
+    auto work = [&](int threadIndex) {
+        int chunkBegin;
+        while ((chunkBegin = nextChunk.fetch_add(chunkSize)) < end)
+            for (int i = chunkBegin; i < min(end, chunkBegin + chunkSize); i++)
+                function(i, threadIndex);
+    };
+
+    vector<thread> threads;
+    for (int threadIndex = 1; threadIndex < numberOfThreads; threadIndex++)
+        threads.emplace_back(work, threadIndex);
+    work(0);
+
+    for (auto &worker: threads)
+        worker.join();
+}
+
+
+void atomicMinimum(atomic<int> &value, int candidate) {
+    int current = value.load(memory_order_relaxed);
+    while (candidate < current and not value.compare_exchange_weak(current, candidate, memory_order_relaxed));
+}
+
+
+void atomicMaximum(atomic<int> &value, int candidate) {
+    int current = value.load(memory_order_relaxed);
+    while (candidate > current and not value.compare_exchange_weak(current, candidate, memory_order_relaxed));
+}
+
+
+// concurrent union-find: roots are only ever linked below smaller roots through
+// compare-and-swap, so concurrent unions can't form cycles
+int concurrentFind(vector<atomic<int>> &parentOf, int node) {
+    int parent;
+    while ((parent = parentOf[node].load(memory_order_relaxed)) != node) {
+        // path halving, which is harmless if another thread changes the parent in the meantime
+        int grandparent = parentOf[parent].load(memory_order_relaxed);
+        parentOf[node].compare_exchange_weak(parent, grandparent, memory_order_relaxed);
+        node = parent;
+    }
+    return node;
+}
+
+
+void concurrentUnion(vector<atomic<int>> &parentOf, int firstNode, int secondNode) {
+    while (true) {
+        firstNode = concurrentFind(parentOf, firstNode);
+        secondNode = concurrentFind(parentOf, secondNode);
+
+        if (firstNode == secondNode)
+            return;
+        if (firstNode < secondNode)
+            swap(firstNode, secondNode);
+
+        int expected = firstNode;
+        if (parentOf[firstNode].compare_exchange_strong(expected, secondNode, memory_order_relaxed))
+            return;
+    }
+}
+
+
+struct Biconnectivity {
+    int numberOfNodes, numberOfThreads;
+    vector<pair<int, int>> edges;
+    // compressed incidence lists (self-loops are left out, since they
+    // don't influence articulation points or bridges)
+    vector<int> firstEdgeOf, incidentEdges;
+
+    // spanning forest: parent and tree edge of every node ('-1' for roots),
+    // and the children of every node, in compressed form
+    vector<int> parentOf, parentEdgeOf, firstChildOf, children;
+    vector<int> subtreeSizeOf, preorderOf;
+    vector<atomic<int>> lowOf, highOf;
+
+    vector<bool> isCritical;
+    vector<int> bridges;
+};
+
+
+void buildIncidenceLists(Biconnectivity &graph) {
+    int numberOfNodes = graph.numberOfNodes;
+    graph.firstEdgeOf.assign(numberOfNodes + 1, 0);
+
+    for (auto &edge: graph.edges)
+        if (edge.first != edge.second) {
+            graph.firstEdgeOf[edge.first + 1]++;
+            graph.firstEdgeOf[edge.second + 1]++;
+        }
+    for (int node = 0; node < numberOfNodes; node++)
+        graph.firstEdgeOf[node + 1] += graph.firstEdgeOf[node];
+
+    graph.incidentEdges.resize(graph.firstEdgeOf[numberOfNodes]);
+    vector<int> nextPosition(graph.firstEdgeOf.begin(), graph.firstEdgeOf.end() - 1);
+    for (int edge = 0; edge < (int) graph.edges.size(); edge++)
+        if (graph.edges[edge].first != graph.edges[edge].second) {
+            graph.incidentEdges[nextPosition[graph.edges[edge].first]++] = edge;
+            graph.incidentEdges[nextPosition[graph.edges[edge].second]++] = edge;
+        }
+}
+
+
+// parallel BFS from every node not reached yet; 'levels' receives the BFS levels of
+// every tree, one after the other, and 'treeRoots' the positions at which the trees begin
+void buildSpanningForest(Biconnectivity &graph, vector<vector<int>> &levels, vector<int> &treeRoots) {
+    int numberOfNodes = graph.numberOfNodes, numberOfThreads = graph.numberOfThreads;
+    vector<atomic<char>> isReached(numberOfNodes);
+    vector<vector<int>> buffers(numberOfThreads);
+
+    graph.parentOf.assign(numberOfNodes, -1);
+    graph.parentEdgeOf.assign(numberOfNodes, -1);
+    for (int node = 0; node < numberOfNodes; node++)
+        isReached[node].store(0, memory_order_relaxed);
+
+    for (int root = 0; root < numberOfNodes; root++) {
+        if (isReached[root].load(memory_order_relaxed))
+            continue;
+
+        isReached[root].store(1, memory_order_relaxed);
+        treeRoots.push_back((int) levels.size());
+        levels.push_back({root});
+
+        while (true) {
+            const vector<int> &frontier = levels.back();
+
+            parallelFor(0, (int) frontier.size(), numberOfThreads, [&](int i, int threadIndex) {
+                int node = frontier[i];
+                for (int position = graph.firstEdgeOf[node]; position < graph.firstEdgeOf[node + 1]; position++) {
+                    int edge = graph.incidentEdges[position];
+                    int adjacentNode = graph.edges[edge].first ^ graph.edges[edge].second ^ node;
+
+                    // the thread which marks the node first makes it its child
+                    if (isReached[adjacentNode].load(memory_order_relaxed) == 0 and
+                        isReached[adjacentNode].exchange(1, memory_order_relaxed) == 0) {
+                        graph.parentOf[adjacentNode] = node;
+                        graph.parentEdgeOf[adjacentNode] = edge;
+                        buffers[threadIndex].push_back(adjacentNode);
+                    }
+                }
+            });
+
+            vector<int> nextLevel;
+            for (auto &buffer: buffers) {
+                nextLevel.insert(nextLevel.end(), buffer.begin(), buffer.end());
+                buffer.clear();
+            }
+
+            if (nextLevel.empty())
+                break;
+            levels.push_back(move(nextLevel));
+        }
+    }
+}
+
+
+// subtree sizes (bottom-up) and preorder numbers (top-down), one BFS level at a time
+void numberInPreorder(Biconnectivity &graph, const vector<vector<int>> &levels, const vector<int> &treeRoots) {
+    int numberOfNodes = graph.numberOfNodes, numberOfThreads = graph.numberOfThreads;
+
+    // children lists, grouped by parent (counting sort)
+    graph.firstChildOf.assign(numberOfNodes + 1, 0);
+    for (int node = 0; node < numberOfNodes; node++)
+        if (graph.parentOf[node] != -1)
+            graph.firstChildOf[graph.parentOf[node] + 1]++;
+    for (int node = 0; node < numberOfNodes; node++)
+        graph.firstChildOf[node + 1] += graph.firstChildOf[node];
+
+    graph.children.resize(graph.firstChildOf[numberOfNodes]);
+    vector<int> nextPosition(graph.firstChildOf.begin(), graph.firstChildOf.end() - 1);
+    for (int node = 0; node < numberOfNodes; node++)
+        if (graph.parentOf[node] != -1)
+            graph.children[nextPosition[graph.parentOf[node]]++] = node;
+
+    // a level is only processed once the level below it is complete,
+    // so the size of every child is final by the time it is added up
+    vector<atomic<int>> sizeOf(numberOfNodes);
+    for (int node = 0; node < numberOfNodes; node++)
+        sizeOf[node].store(1, memory_order_relaxed);
+
+    for (int level = (int) levels.size() - 1; level >= 0; level--)
+        parallelFor(0, (int) levels[level].size(), numberOfThreads, [&](int i, int /*threadIndex*/) {
+            int node = levels[level][i];
+            if (graph.parentOf[node] != -1)
+                sizeOf[graph.parentOf[node]].fetch_add(sizeOf[node].load(memory_order_relaxed),
+                                                       memory_order_relaxed);
+        });
+
+    graph.subtreeSizeOf.resize(numberOfNodes);
+    for (int node = 0; node < numberOfNodes; node++)
+        graph.subtreeSizeOf[node] = sizeOf[node].load(memory_order_relaxed);
+
+    // every tree takes the next block of preorder numbers, and inside a tree, every
+    // child's subtree follows the subtrees of its preceding siblings
+    graph.preorderOf.assign(numberOfNodes, 0);
+    int nextNumber = 0;
+    for (auto treeRoot: treeRoots) {
+        int root = levels[treeRoot][0];
+        graph.preorderOf[root] = nextNumber;
+        nextNumber += graph.subtreeSizeOf[root];
+    }
+
+    for (int level = 0; level < (int) levels.size(); level++)
+        parallelFor(0, (int) levels[level].size(), numberOfThreads, [&](int i, int /*threadIndex*/) {
+            int node = levels[level][i], number = graph.preorderOf[node] + 1;
+            for (int position = graph.firstChildOf[node]; position < graph.firstChildOf[node + 1]; position++) {
+                int child = graph.children[position];
+                graph.preorderOf[child] = number;
+                number += graph.subtreeSizeOf[child];
+            }
+        });
+}
+
+
+bool isAncestor(const Biconnectivity &graph, int ancestor, int node) {
+    return graph.preorderOf[ancestor] <= graph.preorderOf[node] and
+           graph.preorderOf[node] < graph.preorderOf[ancestor] + graph.subtreeSizeOf[ancestor];
+}
+
+
+// smallest and largest preorder numbers reachable from every subtree through a single non-tree edge
+void computeLowAndHigh(Biconnectivity &graph, const vector<vector<int>> &levels) {
+    int numberOfNodes = graph.numberOfNodes, numberOfThreads = graph.numberOfThreads;
+    graph.lowOf = vector<atomic<int>>(numberOfNodes);
+    graph.highOf = vector<atomic<int>>(numberOfNodes);
+
+    // every edge except the tree edge leading to the parent counts; tree edges
+    // leading to children stay within the subtree, so they change nothing
+    parallelFor(0, numberOfNodes, numberOfThreads, [&](int node, int /*threadIndex*/) {
+        int low = graph.preorderOf[node], high = graph.preorderOf[node];
+
+        for (int position = graph.firstEdgeOf[node]; position < graph.firstEdgeOf[node + 1]; position++) {
+            int edge = graph.incidentEdges[position];
+            if (edge == graph.parentEdgeOf[node])
+                continue;
+
+            int adjacentNode = graph.edges[edge].first ^ graph.edges[edge].second ^ node;
+            low = min(low, graph.preorderOf[adjacentNode]);
+            high = max(high, graph.preorderOf[adjacentNode]);
+        }
+
+        graph.lowOf[node].store(low, memory_order_relaxed);
+        graph.highOf[node].store(high, memory_order_relaxed);
+    });
+
+    for (int level = (int) levels.size() - 1; level >= 0; level--)
+        parallelFor(0, (int) levels[level].size(), numberOfThreads, [&](int i, int /*threadIndex*/) {
+            int node = levels[level][i], parent = graph.parentOf[node];
+            if (parent != -1) {
+                atomicMinimum(graph.lowOf[parent], graph.lowOf[node].load(memory_order_relaxed));
+                atomicMaximum(graph.highOf[parent], graph.highOf[node].load(memory_order_relaxed));
+            }
+        });
+}
+
+
+void findArticulationPointsAndBridges(Biconnectivity &graph) {
+    int numberOfNodes = graph.numberOfNodes, numberOfThreads = graph.numberOfThreads;
+
+    buildIncidenceLists(graph);
+
+    vector<vector<int>> levels;
+    vector<int> treeRoots;
+    buildSpanningForest(graph, levels, treeRoots);
+    numberInPreorder(graph, levels, treeRoots);
+    computeLowAndHigh(graph, levels);
+
+    // auxiliary graph: every non-root node stands for the tree edge leading to it,
+    // and two tree edges end up in the same set exactly when they share a block
+    vector<atomic<int>> blockParentOf(numberOfNodes);
+    parallelFor(0, numberOfNodes, numberOfThreads, [&](int node, int /*threadIndex*/) {
+        blockParentOf[node].store(node, memory_order_relaxed);
+    });
+
+    // a non-tree edge between two nodes, neither of which is an ancestor of the other,
+    // closes a cycle through the tree edges leading to both of them
+    parallelFor(0, (int) graph.edges.size(), numberOfThreads, [&](int edge, int /*threadIndex*/) {
+        int firstNode = graph.edges[edge].first, secondNode = graph.edges[edge].second;
+        if (firstNode == secondNode or graph.parentEdgeOf[firstNode] == edge or graph.parentEdgeOf[secondNode] == edge)
+            return;
+
+        if (not isAncestor(graph, firstNode, secondNode) and not isAncestor(graph, secondNode, firstNode))
+            concurrentUnion(blockParentOf, firstNode, secondNode);
+    });
+
+    // the tree edges (parent, node) and (grandparent, parent) share a block if
+    // the subtree of 'node' reaches outside the subtree of 'parent'
+    parallelFor(0, numberOfNodes, numberOfThreads, [&](int node, int /*threadIndex*/) {
+        int parent = graph.parentOf[node];
+        if (parent == -1 or graph.parentOf[parent] == -1)
+            return;
+
+        if (graph.lowOf[node].load(memory_order_relaxed) < graph.preorderOf[parent] or
+            graph.highOf[node].load(memory_order_relaxed) >= graph.preorderOf[parent] + graph.subtreeSizeOf[parent])
+            concurrentUnion(blockParentOf, node, parent);
+    });
+
+    // a node is critical when the tree edges touching it belong to more than one block
+    graph.isCritical.assign(numberOfNodes, false);
+    vector<char> isCritical(numberOfNodes, 0);
+    parallelFor(0, numberOfNodes, numberOfThreads, [&](int node, int /*threadIndex*/) {
+        int block = graph.parentOf[node] != -1 ? concurrentFind(blockParentOf, node) : -1;
+
+        for (int position = graph.firstChildOf[node]; position < graph.firstChildOf[node + 1]; position++) {
+            int childBlock = concurrentFind(blockParentOf, graph.children[position]);
+            if (block == -1)
+                block = childBlock;
+            else if (childBlock != block) {
+                isCritical[node] = 1;
+                break;
+            }
+        }
+    });
+
+    for (int node = 0; node < numberOfNodes; node++)
+        graph.isCritical[node] = isCritical[node];
+
+    // a tree edge is a bridge when no other edge leaves the subtree below it
+    graph.bridges.clear();
+    for (int node = 0; node < numberOfNodes; node++)
+        if (graph.parentOf[node] != -1 and graph.lowOf[node].load(memory_order_relaxed) >= graph.preorderOf[node] and
+            graph.highOf[node].load(memory_order_relaxed) < graph.preorderOf[node] + graph.subtreeSizeOf[node])
+            graph.bridges.push_back(graph.parentEdgeOf[node]);
+
+    sort(graph.bridges.begin(), graph.bridges.end());
+}
+
+
+// the number of threads may be given as the first argument (all cores by default)
+int main(int argc, char **argv) {
+    ifstream input("graf.in");
+
+    Biconnectivity graph;
+    graph.numberOfThreads = max(argc > 1 ? atoi(argv[1]) : (int) thread::hardware_concurrency(), 1);
+
+    int numberOfEdges;
+    input >> graph.numberOfNodes >> numberOfEdges;
+
+    graph.edges.resize(numberOfEdges);
+    for (int i = 0; i < numberOfEdges; i++) {
+        input >> graph.edges[i].first >> graph.edges[i].second;
+        graph.edges[i].first--;
+        graph.edges[i].second--;
+    }
+
+    input.close();
+
+    auto start = chrono::steady_clock::now();
+    findArticulationPointsAndBridges(graph);
+    auto finish = chrono::steady_clock::now();
+
+    cerr << graph.numberOfThreads << " threads: "
+         << chrono::duration_cast<chrono::milliseconds>(finish - start).count() << " ms\n";
+
+    // articulation points, as in critical-points.cpp
+    for (int node = 0; node < graph.numberOfNodes; node++)
+        if (graph.isCritical[node])
+            cout << node + 1 << ' ';
+    cout << '\n';
+
+    // bridges, as in critical-edges.cpp (in the order of the input)
+    for (auto edge: graph.bridges)
+        cout << graph.edges[edge].first + 1 << " " << graph.edges[edge].second + 1 << '\n';
+
+    return 0;
+}
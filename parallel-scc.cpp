@@ -0,0 +1,392 @@
+// Parallel SCC decomposition, which combines three techniques:
+// - trimming: nodes without incoming or outgoing edges (among the nodes whose SCC
+// is still unknown) are SCCs on their own, and removing them may create new ones;
+// every round is O(m+n) work split among the threads
+// - forward-backward reachability: the nodes which are both reachable from a pivot and
+// can reach it form the pivot's SCC; choosing the node with the most incoming and
+// outgoing edges as the pivot usually finds the giant SCC in two parallel BFS traversals
+// - coloring: the largest node id which can reach a node is propagated as its color;
+// nodes whose color is their own id are the roots of their SCCs, which are the nodes of
+// the same color that can reach them; all roots are processed in parallel
+// The worst case is O(n*(m+n)), when every coloring round only finds one SCC, but on
+// real-world graphs (a giant SCC plus many small ones) few rounds are needed.
+#include <bits/stdc++.h>
+
+using namespace std;
+
+
+// splits [begin, end) into chunks which are handed out to the threads on demand;
+// 'function(i, threadIndex)' is called for every index, 'threadIndex' being the index of the
+// thread running it, which is useful for accessing per-thread buffers
+template<typename Function>
+void parallelFor(int begin, int end, int numberOfThreads, Function &&function) {
+    const int chunkSize = 1024;
+
+    // not worth starting any threads
+    if (numberOfThreads == 1 or end - begin <= chunkSize) {
+        for (int i = begin; i < end; i++)
+            function(i, 0);
+        return;
+    }
+
+    atomic<int> nextChunk(begin);
+    auto work = [&](int threadIndex) {
+        int chunkBegin;
+        while ((chunkBegin = nextChunk.fetch_add(chunkSize)) < end)
+            for (int i = chunkBegin; i < min(end, chunkBegin + chunkSize); i++)
+                function(i, threadIndex);
+    };
+
+    vector<thread> threads;
+    for (int threadIndex = 1; threadIndex < numberOfThreads; threadIndex++)
+        threads.emplace_back(work, threadIndex);
+    work(0);
+
+    for (auto &worker: threads)
+        worker.join();
+}
+
+
+// compressed adjacency list: the adjacent nodes of 'node' are
+// 'adjacentNodes[firstEdgeOf[node]]', ..., 'adjacentNodes[firstEdgeOf[node + 1] - 1]'
+void buildCompressedAdjacencyList(int numberOfNodes, const vector<int> &outNodes, const vector<int> &inNodes,
+                                  vector<int> &firstEdgeOf, vector<int> &adjacentNodes) {
+    firstEdgeOf.assign(numberOfNodes + 1, 0);
+    adjacentNodes.resize(outNodes.size());
+
+    for (auto node: outNodes)
+        firstEdgeOf[node + 1]++;
+    for (int node = 0; node < numberOfNodes; node++)
+        firstEdgeOf[node + 1] += firstEdgeOf[node];
+
+    vector<int> nextPosition(firstEdgeOf.begin(), firstEdgeOf.end() - 1);
+    for (int edge = 0; edge < (int) outNodes.size(); edge++)
+        adjacentNodes[nextPosition[outNodes[edge]]++] = inNodes[edge];
+}
+
+
+struct ParallelSCCState {
+    int numberOfNodes, numberOfThreads;
+    const vector<int> &firstOutEdgeOf, &outNodes;
+    const vector<int> &firstInEdgeOf, &inNodes;
+    // the SCC of every node is identified by one of its nodes;
+    // '-1' marks the nodes whose SCC is not yet known (the 'active' ones)
+    vector<atomic<int>> componentOf;
+    // nodes whose SCC is not yet known, refreshed after every phase
+    vector<int> activeNodes;
+
+    ParallelSCCState(int numberOfNodes, int numberOfThreads,
+                     const vector<int> &firstOutEdgeOf, const vector<int> &outNodes,
+                     const vector<int> &firstInEdgeOf, const vector<int> &inNodes)
+            : numberOfNodes(numberOfNodes), numberOfThreads(numberOfThreads),
+              firstOutEdgeOf(firstOutEdgeOf), outNodes(outNodes),
+              firstInEdgeOf(firstInEdgeOf), inNodes(inNodes), componentOf(numberOfNodes) {
+        for (int node = 0; node < numberOfNodes; node++) {
+            componentOf[node].store(-1, memory_order_relaxed);
+            activeNodes.push_back(node);
+        }
+    }
+
+    bool isActive(int node) const {
+        return componentOf[node].load(memory_order_relaxed) == -1;
+    }
+
+    // claims an active node for the given SCC; only one thread may succeed
+    bool assign(int node, int component) {
+        int expected = -1;
+        return componentOf[node].compare_exchange_strong(expected, component, memory_order_relaxed);
+    }
+
+    void refreshActiveNodes() {
+        vector<int> stillActive;
+        for (auto node: activeNodes)
+            if (isActive(node))
+                stillActive.push_back(node);
+        activeNodes.swap(stillActive);
+    }
+
+    // concatenates the per-thread buffers into 'result'
+    static void gather(vector<vector<int>> &buffers, vector<int> &result) {
+        result.clear();
+        for (auto &buffer: buffers) {
+            result.insert(result.end(), buffer.begin(), buffer.end());
+            buffer.clear();
+        }
+    }
+};
+
+
+// repeatedly removes the active nodes without active incoming or outgoing edges
+void trim(ParallelSCCState &state) {
+    int numberOfNodes = state.numberOfNodes, numberOfThreads = state.numberOfThreads;
+    vector<atomic<int>> inDegree(numberOfNodes), outDegree(numberOfNodes);
+    vector<vector<int>> buffers(numberOfThreads);
+    vector<int> frontier;
+
+    // degrees are only counted between active nodes
+    parallelFor(0, (int) state.activeNodes.size(), numberOfThreads, [&](int i, int /*threadIndex*/) {
+        int node = state.activeNodes[i], in = 0, out = 0;
+
+        for (int edge = state.firstOutEdgeOf[node]; edge < state.firstOutEdgeOf[node + 1]; edge++)
+            out += state.isActive(state.outNodes[edge]);
+        for (int edge = state.firstInEdgeOf[node]; edge < state.firstInEdgeOf[node + 1]; edge++)
+            in += state.isActive(state.inNodes[edge]);
+
+        inDegree[node].store(in, memory_order_relaxed);
+        outDegree[node].store(out, memory_order_relaxed);
+    });
+
+    parallelFor(0, (int) state.activeNodes.size(), numberOfThreads, [&](int i, int threadIndex) {
+        int node = state.activeNodes[i];
+        if ((inDegree[node].load(memory_order_relaxed) == 0 or outDegree[node].load(memory_order_relaxed) == 0)
+            and state.assign(node, node))
+            buffers[threadIndex].push_back(node);
+    });
+    ParallelSCCState::gather(buffers, frontier);
+
+    // removing a node lowers the degrees of its neighbours, which may
+    // in turn become trivial SCCs and form the next frontier
+    while (not frontier.empty()) {
+        parallelFor(0, (int) frontier.size(), numberOfThreads, [&](int i, int threadIndex) {
+            int node = frontier[i], adjacentNode;
+
+            for (int edge = state.firstOutEdgeOf[node]; edge < state.firstOutEdgeOf[node + 1]; edge++) {
+                adjacentNode = state.outNodes[edge];
+                if (inDegree[adjacentNode].fetch_sub(1, memory_order_relaxed) == 1 and
+                    state.assign(adjacentNode, adjacentNode))
+                    buffers[threadIndex].push_back(adjacentNode);
+            }
+
+            for (int edge = state.firstInEdgeOf[node]; edge < state.firstInEdgeOf[node + 1]; edge++) {
+                adjacentNode = state.inNodes[edge];
+                if (outDegree[adjacentNode].fetch_sub(1, memory_order_relaxed) == 1 and
+                    state.assign(adjacentNode, adjacentNode))
+                    buffers[threadIndex].push_back(adjacentNode);
+            }
+        });
+        ParallelSCCState::gather(buffers, frontier);
+    }
+
+    state.refreshActiveNodes();
+}
+
+
+// level-synchronous parallel BFS over the active nodes accepted by 'canEnter',
+// marking every reached node in 'isReached'
+template<typename Predicate>
+void parallelReach(ParallelSCCState &state, int sourceNode, const vector<int> &firstEdgeOf,
+                   const vector<int> &adjacentNodes, vector<atomic<char>> &isReached, Predicate &&canEnter) {
+    vector<vector<int>> buffers(state.numberOfThreads);
+    vector<int> frontier = {sourceNode};
+    isReached[sourceNode].store(1, memory_order_relaxed);
+
+    while (not frontier.empty()) {
+        parallelFor(0, (int) frontier.size(), state.numberOfThreads, [&](int i, int threadIndex) {
+            int node = frontier[i];
+            for (int edge = firstEdgeOf[node]; edge < firstEdgeOf[node + 1]; edge++) {
+                int adjacentNode = adjacentNodes[edge];
+                if (state.isActive(adjacentNode) and canEnter(adjacentNode) and
+                    isReached[adjacentNode].load(memory_order_relaxed) == 0 and
+                    isReached[adjacentNode].exchange(1, memory_order_relaxed) == 0)
+                    buffers[threadIndex].push_back(adjacentNode);
+            }
+        });
+        ParallelSCCState::gather(buffers, frontier);
+    }
+}
+
+
+// finds the SCC of the active node with the most (active) incoming and outgoing edges
+void forwardBackward(ParallelSCCState &state) {
+    if (state.activeNodes.empty())
+        return;
+
+    int numberOfNodes = state.numberOfNodes, numberOfThreads = state.numberOfThreads;
+
+    // every thread keeps its own best candidate
+    vector<pair<long long, int>> bestOf(numberOfThreads, {-1, -1});
+    parallelFor(0, (int) state.activeNodes.size(), numberOfThreads, [&](int i, int threadIndex) {
+        int node = state.activeNodes[i];
+        long long score = (long long) (state.firstOutEdgeOf[node + 1] - state.firstOutEdgeOf[node]) *
+                          (state.firstInEdgeOf[node + 1] - state.firstInEdgeOf[node]);
+        bestOf[threadIndex] = max(bestOf[threadIndex], {score, node});
+    });
+    int pivot = max_element(bestOf.begin(), bestOf.end())->second;
+
+    vector<atomic<char>> isForwardReached(numberOfNodes), isBackwardReached(numberOfNodes);
+    parallelFor(0, numberOfNodes, numberOfThreads, [&](int node, int /*threadIndex*/) {
+        isForwardReached[node].store(0, memory_order_relaxed);
+        isBackwardReached[node].store(0, memory_order_relaxed);
+    });
+
+    parallelReach(state, pivot, state.firstOutEdgeOf, state.outNodes, isForwardReached,
+                  [](int) { return true; });
+    // every node of the pivot's SCC was reached forwards, and so was every node
+    // on the paths leading from them back to the pivot
+    parallelReach(state, pivot, state.firstInEdgeOf, state.inNodes, isBackwardReached,
+                  [&](int node) { return isForwardReached[node].load(memory_order_relaxed) == 1; });
+
+    parallelFor(0, (int) state.activeNodes.size(), numberOfThreads, [&](int i, int /*threadIndex*/) {
+        int node = state.activeNodes[i];
+        if (isBackwardReached[node].load(memory_order_relaxed))
+            state.assign(node, pivot);
+    });
+
+    state.refreshActiveNodes();
+}
+
+
+// one round of coloring, followed by the parallel extraction of the SCC of every color's root
+void coloring(ParallelSCCState &state) {
+    int numberOfNodes = state.numberOfNodes, numberOfThreads = state.numberOfThreads;
+    vector<atomic<int>> colorOf(numberOfNodes);
+    // the propagation round in which a node was last added to the frontier
+    vector<atomic<int>> queuedInRound(numberOfNodes);
+    vector<vector<int>> buffers(numberOfThreads);
+
+    parallelFor(0, (int) state.activeNodes.size(), numberOfThreads, [&](int i, int /*threadIndex*/) {
+        int node = state.activeNodes[i];
+        colorOf[node].store(node, memory_order_relaxed);
+        queuedInRound[node].store(0, memory_order_relaxed);
+    });
+
+    // only the nodes whose color grew during the previous round have to push it further
+    vector<int> frontier = state.activeNodes;
+    for (int round = 1; not frontier.empty(); round++) {
+        parallelFor(0, (int) frontier.size(), numberOfThreads, [&](int i, int threadIndex) {
+            int node = frontier[i], color = colorOf[node].load(memory_order_relaxed);
+
+            for (int edge = state.firstOutEdgeOf[node]; edge < state.firstOutEdgeOf[node + 1]; edge++) {
+                int adjacentNode = state.outNodes[edge];
+                if (not state.isActive(adjacentNode))
+                    continue;
+
+                // atomic maximum
+                int adjacentColor = colorOf[adjacentNode].load(memory_order_relaxed);
+                while (adjacentColor < color and
+                       not colorOf[adjacentNode].compare_exchange_weak(adjacentColor, color,
+                                                                       memory_order_relaxed));
+
+                if (adjacentColor < color and queuedInRound[adjacentNode].exchange(round) != round)
+                    buffers[threadIndex].push_back(adjacentNode);
+            }
+        });
+        ParallelSCCState::gather(buffers, frontier);
+    }
+
+    vector<int> roots;
+    for (auto node: state.activeNodes)
+        if (colorOf[node].load(memory_order_relaxed) == node)
+            roots.push_back(node);
+
+    // the SCC of a root consists of the nodes of its color which can reach it;
+    // since colors don't overlap, every root is handled by a single thread,
+    // with a plain (sequential) BFS
+    parallelFor(0, (int) roots.size(), numberOfThreads, [&](int i, int threadIndex) {
+        int root = roots[i];
+        vector<int> &bfsQueue = buffers[threadIndex];
+
+        state.assign(root, root);
+        bfsQueue.assign(1, root);
+
+        for (int position = 0; position < (int) bfsQueue.size(); position++) {
+            int node = bfsQueue[position];
+            for (int edge = state.firstInEdgeOf[node]; edge < state.firstInEdgeOf[node + 1]; edge++) {
+                int adjacentNode = state.inNodes[edge];
+                if (state.isActive(adjacentNode) and colorOf[adjacentNode].load(memory_order_relaxed) == root and
+                    state.assign(adjacentNode, root))
+                    bfsQueue.push_back(adjacentNode);
+            }
+        }
+
+        bfsQueue.clear();
+    });
+
+    state.refreshActiveNodes();
+}
+
+
+// returns the SCC of every node, identified by one of its nodes
+vector<int> findSCCsInParallel(int numberOfNodes, int numberOfThreads,
+                               const vector<int> &firstOutEdgeOf, const vector<int> &outNodes,
+                               const vector<int> &firstInEdgeOf, const vector<int> &inNodes) {
+    ParallelSCCState state(numberOfNodes, numberOfThreads, firstOutEdgeOf, outNodes, firstInEdgeOf, inNodes);
+
+    trim(state);
+    forwardBackward(state);
+    trim(state);
+
+    while (not state.activeNodes.empty()) {
+        coloring(state);
+        trim(state);
+    }
+
+    vector<int> componentOf(numberOfNodes);
+    for (int node = 0; node < numberOfNodes; node++)
+        componentOf[node] = state.componentOf[node].load(memory_order_relaxed);
+
+    return componentOf;
+}
+
+
+// the number of threads may be given as the first argument (all cores by default)
+int main(int argc, char **argv) {
+    int numberOfThreads = argc > 1 ? atoi(argv[1]) : (int) thread::hardware_concurrency();
+    numberOfThreads = max(numberOfThreads, 1);
+
+    int numberOfNodes, numberOfEdges;
+    ifstream input;
+
+    input.open("ctc.in");
+
+    input >> numberOfNodes >> numberOfEdges;
+    vector<int> outNodes(numberOfEdges), inNodes(numberOfEdges);
+
+    for (int i = 0; i < numberOfEdges; i++) {
+        input >> outNodes[i] >> inNodes[i];
+        outNodes[i]--;
+        inNodes[i]--;
+    }
+
+    input.close();
+
+    vector<int> firstOutEdgeOf, adjacentOutNodes, firstInEdgeOf, adjacentInNodes;
+    buildCompressedAdjacencyList(numberOfNodes, outNodes, inNodes, firstOutEdgeOf, adjacentOutNodes);
+    buildCompressedAdjacencyList(numberOfNodes, inNodes, outNodes, firstInEdgeOf, adjacentInNodes);
+
+    vector<int>().swap(outNodes);
+    vector<int>().swap(inNodes);
+
+    auto start = chrono::steady_clock::now();
+    vector<int> componentOf = findSCCsInParallel(numberOfNodes, numberOfThreads, firstOutEdgeOf, adjacentOutNodes,
+                                                 firstInEdgeOf, adjacentInNodes);
+    auto finish = chrono::steady_clock::now();
+
+    cerr << numberOfThreads << " threads: "
+         << chrono::duration_cast<chrono::milliseconds>(finish - start).count() << " ms\n";
+
+    // the SCCs are written in the same format as kosaraju.cpp, ordered by their smallest node
+    // (the order in which the SCCs are found depends on the scheduling of the threads)
+    vector<vector<int>> nodesOf(numberOfNodes);
+    for (int node = 0; node < numberOfNodes; node++)
+        nodesOf[componentOf[node]].push_back(node);
+
+    vector<int> smallestNodes;
+    for (int node = 0; node < numberOfNodes; node++)
+        if (nodesOf[componentOf[node]].front() == node)
+            smallestNodes.push_back(node);
+
+    ofstream output;
+    output.open("ctc.out");
+    output << smallestNodes.size() << '\n';
+
+    for (auto smallestNode: smallestNodes) {
+        for (auto node: nodesOf[componentOf[smallestNode]])
+            output << node + 1 << ' ';
+        output << '\n';
+    }
+
+    output.close();
+
+    return 0;
+}
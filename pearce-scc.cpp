@@ -0,0 +1,180 @@
+// O(m + n) - a single (iterative) DFS traversal
+// Pearce's space-efficient variant of Tarjan's algorithm: unlike kosaraju.cpp,
+// no transposed graph is needed, while the DFS index, the lowlink value and the
+// component of every node all share a single integer per node ('rindex')
+#include <bits/stdc++.h>
+
+using namespace std;
+
+
+// the graph is stored in compressed form: the adjacent nodes of 'node' are
+// 'adjacentNodes[firstEdgeOf[node]]', ..., 'adjacentNodes[firstEdgeOf[node + 1] - 1]'
+void buildCompressedAdjacencyList(int numberOfNodes, const vector<int> &outNodes, const vector<int> &inNodes,
+                                  vector<int> &firstEdgeOf, vector<int> &adjacentNodes) {
+    firstEdgeOf.assign(numberOfNodes + 1, 0);
+    adjacentNodes.resize(outNodes.size());
+
+    // counting the out-degree of every node, then turning
+    // the counts into the starting positions of every list
+    for (auto node: outNodes)
+        firstEdgeOf[node + 1]++;
+    for (int node = 0; node < numberOfNodes; node++)
+        firstEdgeOf[node + 1] += firstEdgeOf[node];
+
+    vector<int> nextPosition(firstEdgeOf.begin(), firstEdgeOf.end() - 1);
+    for (int edge = 0; edge < (int) outNodes.size(); edge++)
+        adjacentNodes[nextPosition[outNodes[edge]]++] = inNodes[edge];
+}
+
+
+// returns the number of SCCs; 'componentOf' receives the SCC of every node, numbered
+// in the topological order of the condensation (SCC 0 has no incoming edges from
+// other SCCs, while edges between different SCCs always go from lower to higher ids)
+int findSCCs(int numberOfNodes, const vector<int> &firstEdgeOf, const vector<int> &adjacentNodes,
+             vector<int> &componentOf) {
+    // while a node is being traversed, 'rindex' holds the smallest DFS index reachable
+    // from it (initially its own index); once its SCC is complete, it holds the SCC
+    // number, which counts down from 'numberOfNodes - 1', so that it is always larger
+    // than the indices still in use and never gets picked up as a smaller index
+    vector<int> &rindex = componentOf;
+    rindex.assign(numberOfNodes, 0);    // '0' marks unvisited nodes
+
+    // whether a node's own index is still the smallest one reachable from it,
+    // which makes it the root (first visited node) of its SCC
+    vector<bool> isRoot(numberOfNodes, false);
+
+    // (node, next edge to be checked) pairs on the current DFS path
+    vector<pair<int, int>> callStack;
+    // visited nodes whose SCC is not yet complete
+    vector<int> componentStack;
+
+    int index = 1, component = numberOfNodes - 1;
+
+    auto beginVisiting = [&](int node) {
+        rindex[node] = index++;
+        isRoot[node] = true;
+        callStack.emplace_back(node, firstEdgeOf[node]);
+    };
+
+    auto finishEdge = [&](int node, int adjacentNode) {
+        if (rindex[adjacentNode] < rindex[node]) {
+            rindex[node] = rindex[adjacentNode];
+            isRoot[node] = false;
+        }
+    };
+
+    auto finishVisiting = [&](int node) {
+        if (not isRoot[node]) {
+            componentStack.push_back(node);
+            return;
+        }
+
+        // every node pushed after the root belongs to its SCC; their indices are
+        // given back, so that the SCC numbers and the indices never overlap
+        index--;
+        while (not componentStack.empty() and rindex[node] <= rindex[componentStack.back()]) {
+            rindex[componentStack.back()] = component;
+            componentStack.pop_back();
+            index--;
+        }
+
+        rindex[node] = component--;
+    };
+
+    for (int sourceNode = 0; sourceNode < numberOfNodes; sourceNode++) {
+        if (rindex[sourceNode] != 0)
+            continue;
+
+        beginVisiting(sourceNode);
+
+        while (not callStack.empty()) {
+            int node = callStack.back().first, edge = callStack.back().second;
+
+            if (edge < firstEdgeOf[node + 1]) {
+                int adjacentNode = adjacentNodes[edge];
+
+                // the edge is only finished once the traversal returns to 'node'
+                if (rindex[adjacentNode] == 0) {
+                    beginVisiting(adjacentNode);
+                    continue;
+                }
+
+                finishEdge(node, adjacentNode);
+                callStack.back().second++;
+            } else {
+                callStack.pop_back();
+                finishVisiting(node);
+
+                // returning to the parent node, whose current edge led to 'node'
+                if (not callStack.empty()) {
+                    finishEdge(callStack.back().first, node);
+                    callStack.back().second++;
+                }
+            }
+        }
+    }
+
+    // SCCs were numbered in the order they were completed, counting down from
+    // 'numberOfNodes - 1', and the last one to be completed comes first in the
+    // topological order; shifting the numbers makes them start from 0
+    int numberOfSCCs = numberOfNodes - 1 - component;
+    for (int node = 0; node < numberOfNodes; node++)
+        componentOf[node] -= component + 1;
+
+    return numberOfSCCs;
+}
+
+
+int main() {
+    int numberOfNodes, numberOfEdges;
+    ifstream input;
+
+    input.open("ctc.in");
+
+    input >> numberOfNodes >> numberOfEdges;
+    vector<int> outNodes(numberOfEdges), inNodes(numberOfEdges);
+
+    for (int i = 0; i < numberOfEdges; i++) {
+        input >> outNodes[i] >> inNodes[i];
+        outNodes[i]--;
+        inNodes[i]--;
+    }
+
+    input.close();
+
+    vector<int> firstEdgeOf, adjacentNodes;
+    buildCompressedAdjacencyList(numberOfNodes, outNodes, inNodes, firstEdgeOf, adjacentNodes);
+
+    // the edge list is no longer needed
+    vector<int>().swap(outNodes);
+    vector<int>().swap(inNodes);
+
+    vector<int> componentOf;
+    int numberOfSCCs = findSCCs(numberOfNodes, firstEdgeOf, adjacentNodes, componentOf);
+
+    // grouping the nodes of every SCC together (counting sort by SCC), in order to
+    // write the SCCs in topological order, just like kosaraju.cpp does
+    vector<int> firstNodeOf(numberOfSCCs + 1, 0), nodesByComponent(numberOfNodes);
+    for (int node = 0; node < numberOfNodes; node++)
+        firstNodeOf[componentOf[node] + 1]++;
+    for (int component = 0; component < numberOfSCCs; component++)
+        firstNodeOf[component + 1] += firstNodeOf[component];
+
+    vector<int> nextPosition(firstNodeOf.begin(), firstNodeOf.end() - 1);
+    for (int node = 0; node < numberOfNodes; node++)
+        nodesByComponent[nextPosition[componentOf[node]]++] = node;
+
+    ofstream output;
+    output.open("ctc.out");
+    output << numberOfSCCs << '\n';
+
+    for (int component = 0; component < numberOfSCCs; component++) {
+        for (int i = firstNodeOf[component]; i < firstNodeOf[component + 1]; i++)
+            output << nodesByComponent[i] + 1 << ' ';
+        output << '\n';
+    }
+
+    output.close();
+
+    return 0;
+}
@@ -0,0 +1,419 @@
+// Shortest cycles (the girth, and the shortest cycle through every node), in directed or undirected graphs
+// - girth: O(n*m) in the worst case, but usually far less - a BFS is run from every node (in
+// parallel), and every BFS stops as soon as it can't find anything shorter than the best cycle
+// found so far by any thread, which for sparse graphs with short cycles means a few levels
+// - shortest cycle through every node: O(n*m) in the worst case - a BFS from the node, stopping
+// once it can't improve on the best cycle through that node
+//
+//      In directed graphs, a BFS from r finds the shortest cycle through r at the first edge leading
+// back to r. In undirected graphs, every non-tree edge (x, y) of the BFS tree closes the closed walk
+// r -> x - y -> r; the walk is trimmed at the lowest common ancestor of x and y to get a simple cycle,
+// and the shortest cycle of the graph comes up exactly when r lies on it. For the shortest cycle through
+// r itself, every node is labeled with the child of r its tree path starts with (its 'branch'): the
+// non-tree edges between different branches are exactly those whose walks are cycles through r.
+#include <bits/stdc++.h>
+
+using namespace std;
+
+
+// buffered reader for large inputs: the file is read in blocks of 64KB,
+// instead of parsing one token at a time through 'ifstream'
+struct InputReader {
+    FILE *file;
+    char buffer[1 << 16];
+    int size = 0, position = 0;
+
+    explicit InputReader(const char *fileName) : file(fopen(fileName, "r")) {}
+
+    ~InputReader() {
+        if (file)
+            fclose(file);
+    }
+
+    int nextCharacter() {
+        if (position == size) {
+            size = (int) fread(buffer, 1, sizeof(buffer), file);
+            position = 0;
+            if (size <= 0)
+                return EOF;
+        }
+        return (unsigned char) buffer[position++];
+    }
+
+    // returns false once the end of the file is reached
+    bool readInt(int &value) {
+        int character = nextCharacter();
+        while (character != EOF and character != '-' and not isdigit(character))
+            character = nextCharacter();
+        if (character == EOF)
+            return false;
+
+        bool isNegative = character == '-';
+        if (isNegative)
+            character = nextCharacter();
+
+        value = 0;
+        for (; character != EOF and isdigit(character); character = nextCharacter())
+            value = value * 10 + (character - '0');
+        if (isNegative)
+            value = -value;
+
+        return true;
+    }
+};
+
+
+// splits [begin, end) into chunks which are handed out to the threads on demand;
+// 'function(i, threadIndex)' is called for every index, 'threadIndex' being the index of the
+// thread running it, which is useful for accessing per-thread buffers
+template<typename Function>
+void parallelFor(int begin, int end, int numberOfThreads, Function &&function) {
+    // every index is a whole BFS, so chunks are kept short
+    const int chunkSize = 16;
+
+    // not worth starting any threads
+    if (numberOfThreads == 1 or end - begin <= chunkSize) {
+        for (int i = begin; i < end; i++)
+            function(i, 0);
+        return;
+    }
+
+    atomic<int> nextChunk(begin);
+    auto work = [&](int threadIndex) {
+        int chunkBegin;
+        while ((chunkBegin = nextChunk.fetch_add(chunkSize)) < end)
+            for (int i = chunkBegin; i < min(end, chunkBegin + chunkSize); i++)
+                function(i, threadIndex);
+    };
+
+    vector<thread> threads;
+    for (int threadIndex = 1; threadIndex < numberOfThreads; threadIndex++)
+        threads.emplace_back(work, threadIndex);
+    work(0);
+
+    for (auto &worker: threads)
+        worker.join();
+}
+
+
+// compressed adjacency list: the edges leaving 'node' are 'firstEdgeOf[node]', ..., 'firstEdgeOf[node + 1] - 1',
+// each with its other endpoint and the index of the original edge (undirected edges are stored both ways);
+// self-loops are only recorded in 'hasSelfLoop', since they are cycles of length 1 on their own
+struct CycleGraph {
+    int numberOfNodes;
+    bool isDirected;
+    vector<int> firstEdgeOf, adjacentNodes, edgeIndexOf;
+    vector<char> hasSelfLoop;
+};
+
+
+void buildCycleGraph(int numberOfNodes, bool isDirected, const vector<int> &outNodes, const vector<int> &inNodes,
+                     CycleGraph &graph) {
+    graph.numberOfNodes = numberOfNodes;
+    graph.isDirected = isDirected;
+    graph.hasSelfLoop.assign(numberOfNodes, false);
+    graph.firstEdgeOf.assign(numberOfNodes + 1, 0);
+
+    int numberOfEdges = (int) outNodes.size();
+    for (int edge = 0; edge < numberOfEdges; edge++) {
+        if (outNodes[edge] == inNodes[edge]) {
+            graph.hasSelfLoop[outNodes[edge]] = true;
+            continue;
+        }
+
+        graph.firstEdgeOf[outNodes[edge] + 1]++;
+        if (not isDirected)
+            graph.firstEdgeOf[inNodes[edge] + 1]++;
+    }
+    for (int node = 0; node < numberOfNodes; node++)
+        graph.firstEdgeOf[node + 1] += graph.firstEdgeOf[node];
+
+    graph.adjacentNodes.resize(graph.firstEdgeOf[numberOfNodes]);
+    graph.edgeIndexOf.resize(graph.firstEdgeOf[numberOfNodes]);
+    vector<int> nextPosition(graph.firstEdgeOf.begin(), graph.firstEdgeOf.end() - 1);
+
+    auto addEdge = [&](int from, int to, int edge) {
+        graph.adjacentNodes[nextPosition[from]] = to;
+        graph.edgeIndexOf[nextPosition[from]++] = edge;
+    };
+
+    for (int edge = 0; edge < numberOfEdges; edge++) {
+        if (outNodes[edge] == inNodes[edge])
+            continue;
+
+        addEdge(outNodes[edge], inNodes[edge], edge);
+        if (not isDirected)
+            addEdge(inNodes[edge], outNodes[edge], edge);
+    }
+}
+
+
+// per-thread BFS state; nodes count as visited only if they were reached by the current search,
+// so nothing has to be cleared between searches
+struct BFSWorkspace {
+    vector<int> visitedBy, distanceOf, parentOf, parentEdgeOf, branchOf, queue;
+    int currentSearch = 0;
+
+    void startSearch(int numberOfNodes, int root) {
+        if (visitedBy.empty()) {
+            visitedBy.assign(numberOfNodes, 0);
+            distanceOf.resize(numberOfNodes);
+            parentOf.resize(numberOfNodes);
+            parentEdgeOf.resize(numberOfNodes);
+            branchOf.resize(numberOfNodes);
+            queue.resize(numberOfNodes);
+        }
+
+        currentSearch++;
+        visit(root, -1, -1, 0);
+    }
+
+    bool isVisited(int node) const {
+        return visitedBy[node] == currentSearch;
+    }
+
+    void visit(int node, int parent, int parentEdge, int distance) {
+        visitedBy[node] = currentSearch;
+        parentOf[node] = parent;
+        parentEdgeOf[node] = parentEdge;
+        distanceOf[node] = distance;
+    }
+};
+
+
+struct ShortestCycle {
+    // 'INT_MAX' if there is no cycle
+    int length = INT_MAX;
+    vector<int> nodes;
+};
+
+
+// the cycle closed by the non-tree edge (x, y) in an undirected BFS tree: both tree
+// paths are climbed up to the lowest common ancestor, which starts the cycle
+vector<int> closeCycle(const BFSWorkspace &workspace, int x, int y) {
+    vector<int> fromX, fromY;
+
+    while (workspace.distanceOf[x] > workspace.distanceOf[y]) {
+        fromX.push_back(x);
+        x = workspace.parentOf[x];
+    }
+    while (workspace.distanceOf[y] > workspace.distanceOf[x]) {
+        fromY.push_back(y);
+        y = workspace.parentOf[y];
+    }
+    while (x != y) {
+        fromX.push_back(x);
+        fromY.push_back(y);
+        x = workspace.parentOf[x];
+        y = workspace.parentOf[y];
+    }
+
+    vector<int> cycle = {x};
+    cycle.insert(cycle.end(), fromX.rbegin(), fromX.rend());
+    cycle.insert(cycle.end(), fromY.begin(), fromY.end());
+    return cycle;
+}
+
+
+// the tree path from the root of the BFS to 'node'
+vector<int> pathFromRoot(const BFSWorkspace &workspace, int node) {
+    vector<int> path;
+    for (; node != -1; node = workspace.parentOf[node])
+        path.push_back(node);
+    reverse(path.begin(), path.end());
+    return path;
+}
+
+
+// shortest cycle of the whole graph, as the list of its nodes
+ShortestCycle findGirth(const CycleGraph &graph, int numberOfThreads) {
+    int numberOfNodes = graph.numberOfNodes;
+    ShortestCycle girth;
+
+    for (int node = 0; node < numberOfNodes; node++)
+        if (graph.hasSelfLoop[node]) {
+            girth.length = 1;
+            girth.nodes = {node};
+            return girth;
+        }
+
+    // the length of the best cycle found by any thread, which every BFS uses as its bound
+    atomic<int> bestLength(INT_MAX);
+    mutex girthLock;
+    vector<BFSWorkspace> workspaces(numberOfThreads);
+
+    auto offerCycle = [&](vector<int> cycle) {
+        lock_guard<mutex> guard(girthLock);
+        if ((int) cycle.size() < girth.length) {
+            girth.length = (int) cycle.size();
+            girth.nodes = move(cycle);
+            bestLength.store(girth.length, memory_order_relaxed);
+        }
+    };
+
+    parallelFor(0, numberOfNodes, numberOfThreads, [&](int root, int threadIndex) {
+        BFSWorkspace &workspace = workspaces[threadIndex];
+        workspace.startSearch(numberOfNodes, root);
+        workspace.queue[0] = root;
+
+        for (int head = 0, tail = 1; head < tail; head++) {
+            int node = workspace.queue[head], distance = workspace.distanceOf[node];
+
+            // every cycle found from here on is at least this long
+            int lowestLength = graph.isDirected ? distance + 1 : 2 * distance + 1;
+            if (lowestLength >= bestLength.load(memory_order_relaxed))
+                break;
+
+            for (int edge = graph.firstEdgeOf[node]; edge < graph.firstEdgeOf[node + 1]; edge++) {
+                int adjacentNode = graph.adjacentNodes[edge];
+
+                if (graph.isDirected) {
+                    if (adjacentNode == root) {
+                        // the first edge back to the root closes the shortest cycle through it
+                        offerCycle(pathFromRoot(workspace, node));
+                        tail = head + 1;
+                        break;
+                    }
+                } else if (workspace.isVisited(adjacentNode)) {
+                    if (graph.edgeIndexOf[edge] != workspace.parentEdgeOf[node] and
+                        distance + workspace.distanceOf[adjacentNode] + 1 < bestLength.load(memory_order_relaxed))
+                        offerCycle(closeCycle(workspace, node, adjacentNode));
+                    continue;
+                }
+
+                if (not workspace.isVisited(adjacentNode)) {
+                    workspace.visit(adjacentNode, node, graph.edgeIndexOf[edge], distance + 1);
+                    workspace.queue[tail++] = adjacentNode;
+                }
+            }
+        }
+    });
+
+    return girth;
+}
+
+
+// the length of the shortest cycle through every node ('-1' for nodes which don't lie on any cycle)
+vector<int> findShortestCycleThroughEveryNode(const CycleGraph &graph, int numberOfThreads) {
+    int numberOfNodes = graph.numberOfNodes;
+    vector<int> shortestCycleThrough(numberOfNodes, -1);
+    vector<BFSWorkspace> workspaces(numberOfThreads);
+
+    parallelFor(0, numberOfNodes, numberOfThreads, [&](int root, int threadIndex) {
+        if (graph.hasSelfLoop[root]) {
+            shortestCycleThrough[root] = 1;
+            return;
+        }
+
+        BFSWorkspace &workspace = workspaces[threadIndex];
+        workspace.startSearch(numberOfNodes, root);
+        workspace.branchOf[root] = -1;
+        workspace.queue[0] = root;
+        int bestLength = INT_MAX;
+
+        for (int head = 0, tail = 1; head < tail; head++) {
+            int node = workspace.queue[head], distance = workspace.distanceOf[node];
+
+            int lowestLength = graph.isDirected ? distance + 1 : 2 * distance + 1;
+            if (lowestLength >= bestLength)
+                break;
+
+            for (int edge = graph.firstEdgeOf[node]; edge < graph.firstEdgeOf[node + 1]; edge++) {
+                int adjacentNode = graph.adjacentNodes[edge];
+
+                if (graph.isDirected) {
+                    if (adjacentNode == root) {
+                        bestLength = distance + 1;
+                        break;
+                    }
+                } else if (workspace.isVisited(adjacentNode)) {
+                    // only edges between different branches close cycles through the root
+                    if (graph.edgeIndexOf[edge] != workspace.parentEdgeOf[node] and
+                        workspace.branchOf[node] != workspace.branchOf[adjacentNode])
+                        bestLength = min(bestLength, distance + workspace.distanceOf[adjacentNode] + 1);
+                    continue;
+                }
+
+                if (not workspace.isVisited(adjacentNode)) {
+                    workspace.visit(adjacentNode, node, graph.edgeIndexOf[edge], distance + 1);
+                    workspace.branchOf[adjacentNode] = node == root ? adjacentNode : workspace.branchOf[node];
+                    workspace.queue[tail++] = adjacentNode;
+                }
+            }
+        }
+
+        if (bestLength != INT_MAX)
+            shortestCycleThrough[root] = bestLength;
+    });
+
+    return shortestCycleThrough;
+}
+
+
+// the number of threads may be given as the first argument (all cores by default)
+int main(int argc, char **argv) {
+    int numberOfThreads = argc > 1 ? atoi(argv[1]) : (int) thread::hardware_concurrency();
+    numberOfThreads = max(numberOfThreads, 1);
+
+    // number of nodes and edges, whether the graph is directed ('1') or not ('0') and whether
+    // the shortest cycle through every node is also needed ('1') or only the girth ('0'),
+    // followed by the edges
+    InputReader input("girth.in");
+    if (not input.file) {
+        cerr << "can't open girth.in\n";
+        return 1;
+    }
+
+    int numberOfNodes = 0, numberOfEdges = 0, isDirected = 0, isEveryNodeNeeded = 0;
+    input.readInt(numberOfNodes);
+    input.readInt(numberOfEdges);
+    input.readInt(isDirected);
+    input.readInt(isEveryNodeNeeded);
+
+    vector<int> outNodes(numberOfEdges), inNodes(numberOfEdges);
+    for (int i = 0; i < numberOfEdges; i++) {
+        input.readInt(outNodes[i]);
+        input.readInt(inNodes[i]);
+        outNodes[i]--;
+        inNodes[i]--;
+    }
+
+    CycleGraph graph;
+    buildCycleGraph(numberOfNodes, isDirected, outNodes, inNodes, graph);
+
+    vector<int>().swap(outNodes);
+    vector<int>().swap(inNodes);
+
+    auto start = chrono::steady_clock::now();
+    ShortestCycle girth = findGirth(graph, numberOfThreads);
+    auto finish = chrono::steady_clock::now();
+
+    cerr << "girth, " << numberOfThreads << " threads: "
+         << chrono::duration_cast<chrono::milliseconds>(finish - start).count() << " ms\n";
+
+    ofstream output;
+    output.open("girth.out");
+
+    // the girth ('-1' for acyclic graphs), followed by one of the shortest cycles
+    output << (girth.length == INT_MAX ? -1 : girth.length) << '\n';
+    for (auto node: girth.nodes)
+        output << node + 1 << ' ';
+    output << '\n';
+
+    if (isEveryNodeNeeded) {
+        start = chrono::steady_clock::now();
+        vector<int> shortestCycleThrough = findShortestCycleThroughEveryNode(graph, numberOfThreads);
+        finish = chrono::steady_clock::now();
+
+        cerr << "every node, " << numberOfThreads << " threads: "
+             << chrono::duration_cast<chrono::milliseconds>(finish - start).count() << " ms\n";
+
+        for (int node = 0; node < numberOfNodes; node++)
+            output << shortestCycleThrough[node] << ' ';
+        output << '\n';
+    }
+
+    output.close();
+
+    return 0;
+}
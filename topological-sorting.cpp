@@ -1,7 +1,131 @@
 #include <bits/stdc++.h>
 using namespace std;
 
+
+// splits [begin, end) into chunks which are handed out to the threads on demand;
+// 'function(i, threadIndex)' is called for every index, 'threadIndex' being the index of the
+// thread running it, which is useful for accessing per-thread buffers
+template<typename Function>
+void parallelFor(int begin, int end, int numberOfThreads, Function &&function) {
+    const int chunkSize = 1024;
+
+    // not worth starting any threads
+    if (numberOfThreads == 1 or end - begin <= chunkSize) {
+        for (int i = begin; i < end; i++)
+            function(i, 0);
+        return;
+    }
+
+    atomic<int> nextChunk(begin);
+    auto work = [&](int threadIndex) {
+        int chunkBegin;
+        while ((chunkBegin = nextChunk.fetch_add(chunkSize)) < end)
+            for (int i = chunkBegin; i < min(end, chunkBegin + chunkSize); i++)
+                function(i, threadIndex);
+    };
+
+    vector<thread> threads;
+    for (int threadIndex = 1; threadIndex < numberOfThreads; threadIndex++)
+        threads.emplace_back(work, threadIndex);
+    work(0);
+
+    for (auto &worker: threads)
+        worker.join();
+}
+
+
+// compressed adjacency list, built from the (weighted) adjacency list: the adjacent nodes of 'node'
+// are 'adjacentNodes[firstEdgeOf[node]]', ..., 'adjacentNodes[firstEdgeOf[node + 1] - 1]'
+void buildCompressedAdjacencyList(int numberOfNodes, vector<pair<int, int>> *adjacencyList,
+                                  vector<int> &firstEdgeOf, vector<int> &adjacentNodes) {
+    firstEdgeOf.assign(numberOfNodes + 1, 0);
+    for (int node = 0; node < numberOfNodes; node++)
+        firstEdgeOf[node + 1] = firstEdgeOf[node] + (int) adjacencyList[node].size();
+
+    adjacentNodes.resize(firstEdgeOf[numberOfNodes]);
+    for (int node = 0; node < numberOfNodes; node++)
+        for (int i = 0; i < (int) adjacencyList[node].size(); i++)
+            adjacentNodes[firstEdgeOf[node] + i] = adjacencyList[node][i].first;
+}
+
+
+struct LeveledTopologicalOrder {
+    // the sorted nodes, level after level (the order inside a level depends on the scheduling of the threads)
+    vector<int> order;
+    // level of every node: the length of the longest path leading to it ('-1' for nodes
+    // which lie on a cycle or can be reached from one, and thus never reach a null in-degree)
+    vector<int> levelOf;
+    // 'order[firstNodeOfLevel[level]]', ..., 'order[firstNodeOfLevel[level + 1] - 1]' make up every level
+    vector<int> firstNodeOfLevel;
+    // nodes which lie on a cycle (in increasing order)
+    vector<int> cycleNodes;
+};
+
+
+// the nodes left without a level lie on a cycle or can be reached from one; those on a cycle are the nodes of the
+// strongly connected components with more than one node (or with a self-loop) among them, found with an iterative
+// version of Tarjan's algorithm (every successor of a node without a level has no level either)
+vector<int> findNodesOnCycles(int numberOfNodes, const vector<int> &firstEdgeOf, const vector<int> &adjacentNodes,
+                              const vector<int> &levelOf) {
+    vector<int> indexOf(numberOfNodes, -1), lowLinkOf(numberOfNodes);
+    vector<char> isOnStack(numberOfNodes, false), hasSelfLoop(numberOfNodes, false);
+    vector<int> nodeStack, cycleNodes;
+    // (node, next edge) pairs of the current path
+    vector<pair<int, int>> frameStack;
+    int nextIndex = 0;
+
+    for (int sourceNode = 0; sourceNode < numberOfNodes; sourceNode++) {
+        if (levelOf[sourceNode] != -1 or indexOf[sourceNode] != -1)
+            continue;
+
+        indexOf[sourceNode] = lowLinkOf[sourceNode] = nextIndex++;
+        nodeStack.push_back(sourceNode);
+        isOnStack[sourceNode] = true;
+        frameStack.emplace_back(sourceNode, firstEdgeOf[sourceNode]);
+
+        while (not frameStack.empty()) {
+            int node = frameStack.back().first;
+
+            if (frameStack.back().second < firstEdgeOf[node + 1]) {
+                int adjacentNode = adjacentNodes[frameStack.back().second++];
+
+                if (adjacentNode == node)
+                    hasSelfLoop[node] = true;
+                else if (indexOf[adjacentNode] == -1) {
+                    indexOf[adjacentNode] = lowLinkOf[adjacentNode] = nextIndex++;
+                    nodeStack.push_back(adjacentNode);
+                    isOnStack[adjacentNode] = true;
+                    frameStack.emplace_back(adjacentNode, firstEdgeOf[adjacentNode]);
+                } else if (isOnStack[adjacentNode])
+                    lowLinkOf[node] = min(lowLinkOf[node], indexOf[adjacentNode]);
+                continue;
+            }
+
+            frameStack.pop_back();
+            if (not frameStack.empty())
+                lowLinkOf[frameStack.back().first] = min(lowLinkOf[frameStack.back().first], lowLinkOf[node]);
+
+            // 'node' is the root of a strongly connected component, made up of the nodes above it on the stack
+            if (lowLinkOf[node] == indexOf[node]) {
+                int componentBegin = (int) nodeStack.size();
+                do
+                    isOnStack[nodeStack[--componentBegin]] = false;
+                while (nodeStack[componentBegin] != node);
+
+                if ((int) nodeStack.size() - componentBegin > 1 or hasSelfLoop[node])
+                    cycleNodes.insert(cycleNodes.end(), nodeStack.begin() + componentBegin, nodeStack.end());
+                nodeStack.resize(componentBegin);
+            }
+        }
+    }
+
+    sort(cycleNodes.begin(), cycleNodes.end());
+    return cycleNodes;
+}
+
+
 // Kahn's algorithm for topological sorting
+// 'topologicalOrder' needs 'numberOfNodes + 1' positions, the first one being used for marking cycles
 void getTopologicalOrder(int numberOfNodes, vector<pair<int, int>> *adjacencyList, int *topologicalOrder) {
     // since at every step of the algorithm the nodes
     // with a null in-degree are chosen, an array that
@@ -31,6 +155,7 @@ void getTopologicalOrder(int numberOfNodes, vector<pair<int, int>> *adjacencyLis
         }
 
     // i - incremented index used to store nodes in 'topologicalOrder' array
+    // (the first position is reserved for marking cycles, so the order starts at position 1)
     // count - incremented whenever a new node with a null in-degree is popped from the queue
     int i = 1, count = 0, currentNode;
     // in case of a DAG (directed acyclic graph), all nodes will get
@@ -56,12 +181,75 @@ void getTopologicalOrder(int numberOfNodes, vector<pair<int, int>> *adjacencyLis
         count++;
     }
 
-    // a cycle was encountered => marking first position as -1
-    if (count <= numberOfNodes)
-        topologicalOrder[0] = -1;
+    // a cycle was encountered => marking first position as -1;
+    // otherwise, it holds the number of sorted nodes
+    topologicalOrder[0] = count < numberOfNodes ? -1 : count;
 }
 
-int main() {
+
+// level-synchronous version of Kahn's algorithm: all the nodes with a null in-degree form
+// the current level and are processed concurrently, and the nodes whose in-degrees drop
+// to zero (through atomic decrements) while doing so form the next level
+// O(n + m) work, spread over as many rounds as there are levels
+LeveledTopologicalOrder getTopologicalOrderInParallel(int numberOfNodes, int numberOfThreads,
+                                                      const vector<int> &firstEdgeOf,
+                                                      const vector<int> &adjacentNodes) {
+    LeveledTopologicalOrder result;
+    result.levelOf.assign(numberOfNodes, -1);
+    result.order.reserve(numberOfNodes);
+
+    vector<atomic<int>> inDegrees(numberOfNodes);
+    parallelFor(0, numberOfNodes, numberOfThreads, [&](int node, int /*threadIndex*/) {
+        inDegrees[node].store(0, memory_order_relaxed);
+    });
+    parallelFor(0, (int) adjacentNodes.size(), numberOfThreads, [&](int edge, int /*threadIndex*/) {
+        inDegrees[adjacentNodes[edge]].fetch_add(1, memory_order_relaxed);
+    });
+
+    for (int node = 0; node < numberOfNodes; node++)
+        if (inDegrees[node].load(memory_order_relaxed) == 0)
+            result.order.push_back(node);
+
+    // every thread collects the nodes it releases into its own buffer; the buffers are
+    // appended to the order once the level is done, which gives the next level
+    vector<vector<int>> buffers(numberOfThreads);
+    int levelBegin = 0, level = 0;
+
+    while (levelBegin < (int) result.order.size()) {
+        int levelEnd = (int) result.order.size();
+        result.firstNodeOfLevel.push_back(levelBegin);
+
+        parallelFor(levelBegin, levelEnd, numberOfThreads, [&](int i, int threadIndex) {
+            int node = result.order[i];
+            result.levelOf[node] = level;
+
+            for (int edge = firstEdgeOf[node]; edge < firstEdgeOf[node + 1]; edge++)
+                // only one thread sees the in-degree of a node drop from 1 to 0
+                if (inDegrees[adjacentNodes[edge]].fetch_sub(1, memory_order_relaxed) == 1)
+                    buffers[threadIndex].push_back(adjacentNodes[edge]);
+        });
+
+        for (auto &buffer: buffers) {
+            result.order.insert(result.order.end(), buffer.begin(), buffer.end());
+            buffer.clear();
+        }
+
+        levelBegin = levelEnd;
+        level++;
+    }
+    result.firstNodeOfLevel.push_back(levelBegin);
+
+    result.cycleNodes = findNodesOnCycles(numberOfNodes, firstEdgeOf, adjacentNodes, result.levelOf);
+
+    return result;
+}
+
+
+// the number of threads may be given as the first argument (all cores by default)
+int main(int argc, char **argv) {
+    int numberOfThreads = argc > 1 ? atoi(argv[1]) : (int) thread::hardware_concurrency();
+    numberOfThreads = max(numberOfThreads, 1);
+
     int numberOfNodes, numberOfEdges, firstNode, secondNode, cost;
 
     ifstream input("easygraph.in");
@@ -77,8 +265,30 @@ int main() {
         adjacencyList[firstNode].emplace_back(secondNode, cost);
     }
 
-    int topologicalOrder[numberOfNodes];
-    getTopologicalOrder(numberOfNodes, adjacencyList, topologicalOrder);
+    vector<int> firstEdgeOf, adjacentNodes;
+    buildCompressedAdjacencyList(numberOfNodes, adjacencyList, firstEdgeOf, adjacentNodes);
+
+    auto start = chrono::steady_clock::now();
+    LeveledTopologicalOrder result = getTopologicalOrderInParallel(numberOfNodes, numberOfThreads, firstEdgeOf,
+                                                                   adjacentNodes);
+    auto finish = chrono::steady_clock::now();
+
+    cerr << numberOfThreads << " threads: "
+         << chrono::duration_cast<chrono::milliseconds>(finish - start).count() << " ms\n";
+
+    // the (partial, if there are cycles) topological order, followed by the level of every node ('-1' for
+    // nodes left out of the order, which lie on a cycle or can be reached from one) and by the nodes on cycles
+    for (auto node: result.order)
+        output << node + 1 << ' ';
+    output << '\n';
+
+    for (int node = 0; node < numberOfNodes; node++)
+        output << result.levelOf[node] << ' ';
+    output << '\n';
+
+    for (auto node: result.cycleNodes)
+        output << node + 1 << ' ';
+    output << '\n';
 
     output.close();
     input.close();
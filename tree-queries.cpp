@@ -0,0 +1,433 @@
+// Lowest common ancestor, ancestor and distance queries on rooted trees (forests), given as parent arrays
+// - online: O(n) preprocessing, O(1) per query - range minimum queries over the DFS order
+// - offline (Tarjan): O((n + q) * log n) for the whole batch, but much less in practice - one DFS, which
+// answers every query once both of its nodes have been visited, using disjoint sets
+//
+//      This replaces the usual Euler tour (2n - 1 entries, range minimum over depths) with the DFS order
+// (n entries, range minimum over the DFS ranks of the parents): for two different nodes u and v, with u
+// coming first, the positions after u up to v only hold nodes of the subtree of their LCA, its children
+// among them included, but not the LCA itself, so the parent ranked first among those nodes is the LCA.
+//      Instead of a sparse table over all the entries, the ranks are split into blocks of 64: a sparse
+// table covers whole blocks, and inside a block every position keeps the bitmask of the positions left
+// on the stack of increasing minima after it was pushed; the lowest bit at or after the left end of a
+// query is then the position of the minimum.
+#include <bits/stdc++.h>
+using namespace std;
+
+
+// buffered reader for large inputs: the file is read in blocks of 64KB,
+// instead of parsing one token at a time through 'ifstream'
+struct InputReader {
+    FILE *file;
+    char buffer[1 << 16];
+    int size = 0, position = 0;
+
+    explicit InputReader(const char *fileName) : file(fopen(fileName, "r")) {}
+
+    ~InputReader() {
+        if (file)
+            fclose(file);
+    }
+
+    int nextCharacter() {
+        if (position == size) {
+            size = (int) fread(buffer, 1, sizeof(buffer), file);
+            position = 0;
+            if (size <= 0)
+                return EOF;
+        }
+        return (unsigned char) buffer[position++];
+    }
+
+    // returns false once the end of the file is reached
+    bool readInt(int &value) {
+        int character = nextCharacter();
+        while (character != EOF and character != '-' and not isdigit(character))
+            character = nextCharacter();
+        if (character == EOF)
+            return false;
+
+        bool isNegative = character == '-';
+        if (isNegative)
+            character = nextCharacter();
+
+        value = 0;
+        for (; character != EOF and isdigit(character); character = nextCharacter())
+            value = value * 10 + (character - '0');
+        if (isNegative)
+            value = -value;
+
+        return true;
+    }
+};
+
+
+// compressed lists of children: the children of 'node' are
+// 'children[firstChildOf[node]]', ..., 'children[firstChildOf[node + 1] - 1]';
+// roots have '-1' as their parent
+void buildChildrenLists(const vector<int> &parentOf, vector<int> &firstChildOf, vector<int> &children) {
+    int numberOfNodes = (int) parentOf.size();
+    firstChildOf.assign(numberOfNodes + 1, 0);
+
+    for (auto parent: parentOf)
+        if (parent != -1)
+            firstChildOf[parent + 1]++;
+    for (int node = 0; node < numberOfNodes; node++)
+        firstChildOf[node + 1] += firstChildOf[node];
+
+    children.resize(firstChildOf[numberOfNodes]);
+    vector<int> nextPosition(firstChildOf.begin(), firstChildOf.end() - 1);
+    for (int node = 0; node < numberOfNodes; node++)
+        if (parentOf[node] != -1)
+            children[nextPosition[parentOf[node]]++] = node;
+}
+
+
+// DFS order (preorder) of a forest, the trees coming one after the other; everything
+// but 'rankOf' is indexed by position, so that scans of the order are sequential
+struct TreeOrder {
+    // position of every node in the order, and the node at every position
+    vector<int> rankOf, nodeAt;
+    // position of the parent of the node at every position ('-1' for roots)
+    vector<int> parentRankAt;
+    vector<int> depthAt;
+};
+
+
+// returns false if the parent array isn't a forest
+bool computeDFSOrder(const vector<int> &parentOf, const vector<int> &firstChildOf, const vector<int> &children,
+                     TreeOrder &order) {
+    int numberOfNodes = (int) parentOf.size();
+    order.rankOf.resize(numberOfNodes);
+    order.nodeAt.resize(numberOfNodes);
+    order.parentRankAt.resize(numberOfNodes);
+    order.depthAt.resize(numberOfNodes);
+
+    struct PendingNode {
+        int node, parentRank, depth;
+    };
+
+    // preorder, with a stack of nodes: every subtree still gets a contiguous range of positions,
+    // since it is fully popped before anything below it on the stack; the nodes carry the position
+    // and the depth of their parent, instead of looking them up through the parent array
+    vector<PendingNode> stack;
+    int nextRank = 0;
+    for (int root = 0; root < numberOfNodes; root++) {
+        if (parentOf[root] != -1)
+            continue;
+
+        stack.push_back({root, -1, 0});
+
+        while (not stack.empty()) {
+            PendingNode pending = stack.back();
+            stack.pop_back();
+
+            int rank = nextRank++;
+            order.rankOf[pending.node] = rank;
+            order.nodeAt[rank] = pending.node;
+            order.parentRankAt[rank] = pending.parentRank;
+            order.depthAt[rank] = pending.depth;
+
+            for (int child = firstChildOf[pending.node]; child < firstChildOf[pending.node + 1]; child++) {
+                // with labels unrelated to the shape of the tree, both lookups are cache misses,
+                // so they are started while the nodes wait on the stack
+                __builtin_prefetch(&firstChildOf[children[child]]);
+                __builtin_prefetch(&order.rankOf[children[child]], 1);
+                stack.push_back({children[child], rank, pending.depth + 1});
+            }
+        }
+    }
+
+    // nodes which weren't reached lie on cycles of the parent array
+    return nextRank == numberOfNodes;
+}
+
+
+struct LCAIndex {
+    TreeOrder order;
+    // positions (within the block) on the stack of minima after every position was pushed
+    vector<unsigned long long> stackMaskAt;
+    // 'blockMinimum[level][block]' is the minimum of the blocks 'block', ..., 'block + 2^level - 1'
+    vector<vector<int>> blockMinimum;
+};
+
+
+// returns false if the parent array isn't a forest
+bool buildLCAIndex(const vector<int> &parentOf, const vector<int> &firstChildOf, const vector<int> &children,
+                   LCAIndex &index) {
+    if (not computeDFSOrder(parentOf, firstChildOf, children, index.order))
+        return false;
+
+    int numberOfNodes = (int) parentOf.size();
+    const vector<int> &values = index.order.parentRankAt;
+    int numberOfBlocks = (numberOfNodes + 63) / 64;
+    index.stackMaskAt.resize(numberOfNodes);
+    index.blockMinimum.assign(1, vector<int>(numberOfBlocks));
+
+    for (int block = 0; block < numberOfBlocks; block++) {
+        int blockStart = block * 64, blockEnd = min(numberOfNodes, blockStart + 64);
+        unsigned long long stackMask = 0;
+
+        for (int position = blockStart; position < blockEnd; position++) {
+            // popping the positions which aren't smaller than the current one, the top of the stack being its highest bit
+            while (stackMask and values[blockStart + 63 - __builtin_clzll(stackMask)] >= values[position])
+                stackMask &= ~(1ULL << (63 - __builtin_clzll(stackMask)));
+
+            stackMask |= 1ULL << (position - blockStart);
+            index.stackMaskAt[position] = stackMask;
+        }
+
+        // the bottom of the stack is the minimum of the whole block
+        index.blockMinimum[0][block] = values[blockStart + __builtin_ctzll(stackMask)];
+    }
+
+    for (int level = 1; (1 << level) <= numberOfBlocks; level++) {
+        const vector<int> &previousLevel = index.blockMinimum[level - 1];
+        vector<int> currentLevel(numberOfBlocks - (1 << level) + 1);
+
+        for (int block = 0; block < (int) currentLevel.size(); block++)
+            currentLevel[block] = min(previousLevel[block], previousLevel[block + (1 << (level - 1))]);
+
+        index.blockMinimum.push_back(move(currentLevel));
+    }
+
+    return true;
+}
+
+
+// minimum of 'parentRankAt' over the positions 'left', ..., 'right' of the same block
+inline int minimumInsideBlock(const LCAIndex &index, int left, int right) {
+    unsigned long long stackMask = index.stackMaskAt[right] & (~0ULL << (left & 63));
+    return index.order.parentRankAt[(right & ~63) + __builtin_ctzll(stackMask)];
+}
+
+
+inline int rangeMinimum(const LCAIndex &index, int left, int right) {
+    int leftBlock = left >> 6, rightBlock = right >> 6;
+    if (leftBlock == rightBlock)
+        return minimumInsideBlock(index, left, right);
+
+    int minimum = min(minimumInsideBlock(index, left, leftBlock * 64 + 63),
+                      minimumInsideBlock(index, rightBlock * 64, right));
+
+    // whole blocks in between, covered by two overlapping ranges of the sparse table
+    if (leftBlock + 1 < rightBlock) {
+        int level = 31 - __builtin_clz(rightBlock - leftBlock - 1);
+        const vector<int> &blockMinimum = index.blockMinimum[level];
+        minimum = min({minimum, blockMinimum[leftBlock + 1], blockMinimum[rightBlock - (1 << level)]});
+    }
+
+    return minimum;
+}
+
+
+// position of the LCA of the nodes at two different positions ('-1' if they are in different trees)
+inline int findLCARank(const LCAIndex &index, int firstRank, int secondRank) {
+    if (firstRank > secondRank)
+        swap(firstRank, secondRank);
+
+    // a root between the two nodes (its parent rank being '-1') means that they are in different trees
+    return rangeMinimum(index, firstRank + 1, secondRank);
+}
+
+
+// '-1' if the nodes belong to different trees
+inline int findLCA(const LCAIndex &index, int firstNode, int secondNode) {
+    if (firstNode == secondNode)
+        return firstNode;
+
+    int lcaRank = findLCARank(index, index.order.rankOf[firstNode], index.order.rankOf[secondNode]);
+    return lcaRank == -1 ? -1 : index.order.nodeAt[lcaRank];
+}
+
+
+inline bool isAncestor(const LCAIndex &index, int ancestor, int node) {
+    return findLCA(index, ancestor, node) == ancestor;
+}
+
+
+// number of edges on the path between the nodes ('-1' if they are in different trees)
+inline int findDistance(const LCAIndex &index, int firstNode, int secondNode) {
+    if (firstNode == secondNode)
+        return 0;
+
+    const vector<int> &depthAt = index.order.depthAt;
+    int firstRank = index.order.rankOf[firstNode], secondRank = index.order.rankOf[secondNode];
+    int lcaRank = findLCARank(index, firstRank, secondRank);
+    if (lcaRank == -1)
+        return -1;
+
+    return depthAt[firstRank] + depthAt[secondRank] - 2 * depthAt[lcaRank];
+}
+
+
+// Tarjan's offline algorithm: once a node is finished, its set is merged into the set of its parent,
+// so the representative of any finished node is its lowest ancestor still on the DFS path; a query
+// is answered when its second node finishes, by the representative of the first one
+//      The DFS is replayed from the DFS order, with nodes replaced by their positions: the nodes on
+// the path which aren't ancestors of the next position are exactly those finishing before it
+vector<int> findLCAsOffline(const TreeOrder &order, const vector<pair<int, int>> &queries) {
+    int numberOfNodes = (int) order.nodeAt.size(), numberOfQueries = (int) queries.size();
+
+    // the positions of the nodes of every query
+    vector<pair<int, int>> rankQueries(numberOfQueries);
+    for (int query = 0; query < numberOfQueries; query++)
+        rankQueries[query] = {order.rankOf[queries[query].first], order.rankOf[queries[query].second]};
+
+    // queries grouped by their positions, as a compressed list of query indices
+    vector<int> firstQueryAt(numberOfNodes + 1, 0), queriesAt(2 * numberOfQueries);
+    for (auto &query: rankQueries) {
+        firstQueryAt[query.first + 1]++;
+        firstQueryAt[query.second + 1]++;
+    }
+    for (int rank = 0; rank < numberOfNodes; rank++)
+        firstQueryAt[rank + 1] += firstQueryAt[rank];
+
+    vector<int> nextPosition(firstQueryAt.begin(), firstQueryAt.end() - 1);
+    for (int query = 0; query < numberOfQueries; query++) {
+        queriesAt[nextPosition[rankQueries[query].first]++] = query;
+        queriesAt[nextPosition[rankQueries[query].second]++] = query;
+    }
+    vector<int>().swap(nextPosition);
+
+    vector<int> lcaOf(numberOfQueries, -1);
+    vector<int> representativeOf(numberOfNodes);
+    iota(representativeOf.begin(), representativeOf.end(), 0);
+    // not visited yet (0), on the DFS path (1) or finished (2)
+    vector<char> state(numberOfNodes, 0);
+
+    auto findRepresentative = [&](int rank) {
+        // path halving
+        while (representativeOf[rank] != rank) {
+            representativeOf[rank] = representativeOf[representativeOf[rank]];
+            rank = representativeOf[rank];
+        }
+        return rank;
+    };
+
+    auto finish = [&](int rank) {
+        for (int position = firstQueryAt[rank]; position < firstQueryAt[rank + 1]; position++) {
+            int query = queriesAt[position];
+            int otherRank = rankQueries[query].first == rank ? rankQueries[query].second : rankQueries[query].first;
+
+            if (otherRank == rank)
+                lcaOf[query] = order.nodeAt[rank];
+            else if (state[otherRank] == 2) {
+                // finished trees have nothing left on the path, so their nodes have no common ancestor with this one
+                int representative = findRepresentative(otherRank);
+                lcaOf[query] = state[representative] == 1 ? order.nodeAt[representative] : -1;
+            }
+        }
+
+        state[rank] = 2;
+        if (order.parentRankAt[rank] != -1)
+            representativeOf[rank] = order.parentRankAt[rank];
+    };
+
+    vector<int> path;
+    for (int rank = 0; rank < numberOfNodes; rank++) {
+        // a root empties the whole path
+        while (not path.empty() and path.back() != order.parentRankAt[rank]) {
+            finish(path.back());
+            path.pop_back();
+        }
+
+        state[rank] = 1;
+        path.push_back(rank);
+    }
+
+    while (not path.empty()) {
+        finish(path.back());
+        path.pop_back();
+    }
+
+    return lcaOf;
+}
+
+
+int main() {
+    // the number of nodes, followed by the parent of every node ('0' for roots, as printed by
+    // bfs.cpp and dfs.cpp), then the number of queries, followed by the queries 'a b'
+    InputReader input("treequery.in");
+    if (not input.file) {
+        cerr << "can't open treequery.in\n";
+        return 1;
+    }
+
+    int numberOfNodes = 0;
+    input.readInt(numberOfNodes);
+
+    vector<int> parentOf(numberOfNodes);
+    for (auto &parent: parentOf) {
+        input.readInt(parent);
+        parent--;
+    }
+
+    int numberOfQueries = 0;
+    input.readInt(numberOfQueries);
+
+    vector<pair<int, int>> queries(numberOfQueries);
+    for (auto &query: queries) {
+        input.readInt(query.first);
+        input.readInt(query.second);
+        query.first--;
+        query.second--;
+    }
+
+    vector<int> firstChildOf, children;
+    buildChildrenLists(parentOf, firstChildOf, children);
+
+    auto start = chrono::steady_clock::now();
+    LCAIndex index;
+    if (not buildLCAIndex(parentOf, firstChildOf, children, index)) {
+        cerr << "the parent array contains a cycle\n";
+        return 1;
+    }
+    auto finish = chrono::steady_clock::now();
+
+    // only the DFS order is needed from here on
+    vector<int>().swap(parentOf);
+    vector<int>().swap(firstChildOf);
+    vector<int>().swap(children);
+
+    cerr << "index of " << numberOfNodes << " nodes: "
+         << chrono::duration_cast<chrono::milliseconds>(finish - start).count() << " ms\n";
+
+    auto reportThroughput = [&](const char *name, chrono::steady_clock::duration elapsed) {
+        double seconds = chrono::duration<double>(elapsed).count();
+        cerr << name << ": " << numberOfQueries << " queries in " << (long long) (seconds * 1000) << " ms, "
+             << (long long) (numberOfQueries / max(seconds, 1e-9)) << " queries/s\n";
+    };
+
+    vector<int> lcaOf(numberOfQueries), distanceOf(numberOfQueries);
+    start = chrono::steady_clock::now();
+    for (int query = 0; query < numberOfQueries; query++)
+        lcaOf[query] = findLCA(index, queries[query].first, queries[query].second);
+    finish = chrono::steady_clock::now();
+    reportThroughput("online LCA", finish - start);
+
+    start = chrono::steady_clock::now();
+    for (int query = 0; query < numberOfQueries; query++)
+        distanceOf[query] = findDistance(index, queries[query].first, queries[query].second);
+    finish = chrono::steady_clock::now();
+    reportThroughput("online distance", finish - start);
+
+    // the offline batch is only timed, for comparison, since it gives the same LCAs
+    start = chrono::steady_clock::now();
+    findLCAsOffline(index.order, queries);
+    finish = chrono::steady_clock::now();
+    reportThroughput("offline LCA (Tarjan)", finish - start);
+
+    ofstream output;
+    output.open("treequery.out");
+
+    // for every query 'a b': their LCA, the distance between them and whether a is an ancestor of b
+    // (the LCA and the distance being '-1' if a and b are in different trees)
+    for (int query = 0; query < numberOfQueries; query++)
+        output << lcaOf[query] + (lcaOf[query] != -1) << ' ' << distanceOf[query] << ' '
+               << (lcaOf[query] == queries[query].first) << '\n';
+
+    output.close();
+
+    return 0;
+}
@@ -0,0 +1,236 @@
+// O(n + m) - n variables, m clauses
+// - building the implication graph: 2n nodes (literals) and 2m edges
+// - finding its SCCs with Pearce's algorithm (see pearce-scc.cpp): O(n + m)
+// - extracting the assignment: O(n)
+//
+//      Every clause (a or b) is equivalent to the implications (not a -> b) and
+// (not b -> a). The formula is unsatisfiable exactly when some variable x and its
+// negation end up in the same SCC of the implication graph, since then x implies
+// not x and the other way around. Otherwise, setting every literal whose SCC comes
+// later in the topological order than the SCC of its negation to 'true' satisfies
+// every clause.
+#include <bits/stdc++.h>
+
+using namespace std;
+
+
+// buffered reader for large inputs: the file is read in blocks of 64KB,
+// instead of parsing one token at a time through 'ifstream'
+struct InputReader {
+    FILE *file;
+    char buffer[1 << 16];
+    int size = 0, position = 0;
+
+    explicit InputReader(const char *fileName) : file(fopen(fileName, "r")) {}
+
+    ~InputReader() {
+        if (file)
+            fclose(file);
+    }
+
+    int nextCharacter() {
+        if (position == size) {
+            size = (int) fread(buffer, 1, sizeof(buffer), file);
+            position = 0;
+            if (size <= 0)
+                return EOF;
+        }
+        return (unsigned char) buffer[position++];
+    }
+
+    // returns false once the end of the file is reached
+    bool readInt(int &value) {
+        int character = nextCharacter();
+        while (character != EOF and character != '-' and not isdigit(character))
+            character = nextCharacter();
+        if (character == EOF)
+            return false;
+
+        bool isNegative = character == '-';
+        if (isNegative)
+            character = nextCharacter();
+
+        value = 0;
+        for (; character != EOF and isdigit(character); character = nextCharacter())
+            value = value * 10 + (character - '0');
+        if (isNegative)
+            value = -value;
+
+        return true;
+    }
+};
+
+
+// literal indexing: variable x (counting from 1) is node 2(x-1), while its negation is node 2(x-1)+1,
+// so the negation of any literal is obtained by flipping the lowest bit
+int literalToNode(int literal) {
+    return literal > 0 ? 2 * (literal - 1) : 2 * (-literal - 1) + 1;
+}
+
+
+// compressed adjacency list of the implication graph: the implications of 'node'
+// are 'adjacentNodes[firstEdgeOf[node]]', ..., 'adjacentNodes[firstEdgeOf[node + 1] - 1]'
+void buildImplicationGraph(int numberOfVariables, const vector<int> &firstLiterals,
+                           const vector<int> &secondLiterals, vector<int> &firstEdgeOf,
+                           vector<int> &adjacentNodes) {
+    int numberOfNodes = 2 * numberOfVariables, numberOfClauses = (int) firstLiterals.size();
+    firstEdgeOf.assign(numberOfNodes + 1, 0);
+    adjacentNodes.resize(2 * (size_t) numberOfClauses);
+
+    // (a or b) produces the edges (not a -> b) and (not b -> a)
+    for (int clause = 0; clause < numberOfClauses; clause++) {
+        firstEdgeOf[(firstLiterals[clause] ^ 1) + 1]++;
+        firstEdgeOf[(secondLiterals[clause] ^ 1) + 1]++;
+    }
+    for (int node = 0; node < numberOfNodes; node++)
+        firstEdgeOf[node + 1] += firstEdgeOf[node];
+
+    vector<int> nextPosition(firstEdgeOf.begin(), firstEdgeOf.end() - 1);
+    for (int clause = 0; clause < numberOfClauses; clause++) {
+        adjacentNodes[nextPosition[firstLiterals[clause] ^ 1]++] = secondLiterals[clause];
+        adjacentNodes[nextPosition[secondLiterals[clause] ^ 1]++] = firstLiterals[clause];
+    }
+}
+
+
+// Pearce's iterative SCC algorithm, as in pearce-scc.cpp; SCCs are numbered
+// in the topological order of the condensation
+int findSCCs(int numberOfNodes, const vector<int> &firstEdgeOf, const vector<int> &adjacentNodes,
+             vector<int> &componentOf) {
+    vector<int> &rindex = componentOf;
+    rindex.assign(numberOfNodes, 0);
+    vector<bool> isRoot(numberOfNodes, false);
+    vector<pair<int, int>> callStack;
+    vector<int> componentStack;
+
+    int index = 1, component = numberOfNodes - 1;
+
+    auto beginVisiting = [&](int node) {
+        rindex[node] = index++;
+        isRoot[node] = true;
+        callStack.emplace_back(node, firstEdgeOf[node]);
+    };
+
+    auto finishEdge = [&](int node, int adjacentNode) {
+        if (rindex[adjacentNode] < rindex[node]) {
+            rindex[node] = rindex[adjacentNode];
+            isRoot[node] = false;
+        }
+    };
+
+    auto finishVisiting = [&](int node) {
+        if (not isRoot[node]) {
+            componentStack.push_back(node);
+            return;
+        }
+
+        index--;
+        while (not componentStack.empty() and rindex[node] <= rindex[componentStack.back()]) {
+            rindex[componentStack.back()] = component;
+            componentStack.pop_back();
+            index--;
+        }
+
+        rindex[node] = component--;
+    };
+
+    for (int sourceNode = 0; sourceNode < numberOfNodes; sourceNode++) {
+        if (rindex[sourceNode] != 0)
+            continue;
+
+        beginVisiting(sourceNode);
+
+        while (not callStack.empty()) {
+            int node = callStack.back().first, edge = callStack.back().second;
+
+            if (edge < firstEdgeOf[node + 1]) {
+                int adjacentNode = adjacentNodes[edge];
+
+                if (rindex[adjacentNode] == 0) {
+                    beginVisiting(adjacentNode);
+                    continue;
+                }
+
+                finishEdge(node, adjacentNode);
+                callStack.back().second++;
+            } else {
+                callStack.pop_back();
+                finishVisiting(node);
+
+                if (not callStack.empty()) {
+                    finishEdge(callStack.back().first, node);
+                    callStack.back().second++;
+                }
+            }
+        }
+    }
+
+    int numberOfSCCs = numberOfNodes - 1 - component;
+    for (int node = 0; node < numberOfNodes; node++)
+        componentOf[node] -= component + 1;
+
+    return numberOfSCCs;
+}
+
+
+// returns false if the formula is unsatisfiable; otherwise, 'valueOf'
+// receives a satisfying assignment (valueOf[x] for variable x + 1)
+bool solveTwoSAT(int numberOfVariables, const vector<int> &firstLiterals, const vector<int> &secondLiterals,
+                 vector<bool> &valueOf) {
+    vector<int> firstEdgeOf, adjacentNodes, componentOf;
+    buildImplicationGraph(numberOfVariables, firstLiterals, secondLiterals, firstEdgeOf, adjacentNodes);
+    findSCCs(2 * numberOfVariables, firstEdgeOf, adjacentNodes, componentOf);
+
+    valueOf.assign(numberOfVariables, false);
+    for (int variable = 0; variable < numberOfVariables; variable++) {
+        int positive = componentOf[2 * variable], negative = componentOf[2 * variable + 1];
+
+        if (positive == negative)
+            return false;
+
+        // the literal placed later in the topological order can't imply its negation
+        valueOf[variable] = positive > negative;
+    }
+
+    return true;
+}
+
+
+int main() {
+    // number of variables and clauses, followed by one clause per line,
+    // as two literals: 'x' for variable x and '-x' for its negation
+    InputReader input("2sat.in");
+    if (not input.file) {
+        cerr << "can't open 2sat.in\n";
+        return 1;
+    }
+
+    int numberOfVariables, numberOfClauses;
+    input.readInt(numberOfVariables);
+    input.readInt(numberOfClauses);
+
+    vector<int> firstLiterals, secondLiterals;
+    firstLiterals.reserve(numberOfClauses);
+    secondLiterals.reserve(numberOfClauses);
+
+    int firstLiteral, secondLiteral;
+    while (input.readInt(firstLiteral) and input.readInt(secondLiteral)) {
+        firstLiterals.push_back(literalToNode(firstLiteral));
+        secondLiterals.push_back(literalToNode(secondLiteral));
+    }
+
+    vector<bool> valueOf;
+    bool isSatisfiable = solveTwoSAT(numberOfVariables, firstLiterals, secondLiterals, valueOf);
+
+    ofstream output("2sat.out");
+
+    if (not isSatisfiable)
+        output << -1;
+    else
+        for (int variable = 0; variable < numberOfVariables; variable++)
+            output << valueOf[variable] << ' ';
+
+    output.close();
+
+    return 0;
+}
@@ -0,0 +1,215 @@
+// 0-1 BFS: O(m+n) - each node gets settled only once, while each edge
+// causes at most one push to the double-ended queue
+// Small integer weights (Dial's algorithm): O(m + n + D), where D is the largest
+// distance reached (at most C*(n-1), C being the maximum edge weight)
+// - the C+1 buckets get swept circularly, once for every possible distance
+// Larger weights (Dijkstra's algorithm with a binary heap): O(m*log(n)) - used once C
+// is too large for one bucket per weight
+#include <bits/stdc++.h>
+
+using namespace std;
+
+
+// above this many buckets, the sweep over the (mostly empty) buckets and their
+// memory cost more than the heap used by Dijkstra's algorithm
+const int MAXIMUM_NUMBER_OF_BUCKETS = 1 << 16;
+
+
+// BFS over edges weighing either 0 or 1;
+// the double-ended queue only ever holds nodes with two consecutive distances,
+// 'd' and 'd+1', since nodes reached through 0-weighted edges are pushed at the
+// front and those reached through 1-weighted edges at the back, which means
+// that nodes are popped in increasing order of their distance, just like they
+// would be from the priority queue used by Dijkstra's algorithm
+void zeroOneBFS(int sourceNode, int numberOfNodes, const vector<vector<pair<int, int>>> &adjacencyList,
+                int *parentOf, long long *distanceFromSource) {
+    // '-1' marks nodes which haven't been reached (yet)
+    for (int i = 0; i < numberOfNodes; i++) {
+        parentOf[i] = -1;
+        distanceFromSource[i] = -1;
+    }
+
+    // a node may be pushed twice (a second time after a 0-weighted edge
+    // improves its distance), but only its first pop is processed
+    bool isSettled[numberOfNodes];
+    for (int i = 0; i < numberOfNodes; i++)
+        isSettled[i] = false;
+
+    deque<int> dq;
+
+    distanceFromSource[sourceNode] = 0;
+    dq.push_back(sourceNode);
+
+    int currentNode;
+    while (not dq.empty()) {
+        currentNode = dq.front();
+        dq.pop_front();
+
+        if (isSettled[currentNode])
+            continue;
+        isSettled[currentNode] = true;
+
+        for (auto &adjacentNode: adjacencyList[currentNode]) {
+            int node = adjacentNode.first, weight = adjacentNode.second;
+
+            if (not isSettled[node] and (distanceFromSource[node] == -1 or
+                                         distanceFromSource[currentNode] + weight < distanceFromSource[node])) {
+                parentOf[node] = currentNode;
+                distanceFromSource[node] = distanceFromSource[currentNode] + weight;
+
+                if (weight == 0)
+                    dq.push_front(node);
+                else
+                    dq.push_back(node);
+            }
+        }
+    }
+}
+
+
+// BFS over edges weighing between 0 and 'maximumWeight' (Dial's algorithm);
+// every node waiting to be settled has a distance in the range [d, d + maximumWeight],
+// d being the distance currently processed, therefore 'maximumWeight + 1' buckets,
+// indexed by distance modulo 'maximumWeight + 1', are enough to hold all of them
+void smallWeightBFS(int sourceNode, int numberOfNodes, const vector<vector<pair<int, int>>> &adjacencyList,
+                    int maximumWeight, int *parentOf, long long *distanceFromSource) {
+    for (int i = 0; i < numberOfNodes; i++) {
+        parentOf[i] = -1;
+        distanceFromSource[i] = -1;
+    }
+
+    bool isSettled[numberOfNodes];
+    for (int i = 0; i < numberOfNodes; i++)
+        isSettled[i] = false;
+
+    int numberOfBuckets = maximumWeight + 1;
+    vector<vector<int>> buckets(numberOfBuckets);
+    // number of entries still waiting inside the buckets, outdated ones included
+    int numberOfPendingNodes = 1;
+
+    distanceFromSource[sourceNode] = 0;
+    buckets[0].push_back(sourceNode);
+
+    for (long long currentDistance = 0; numberOfPendingNodes > 0; currentDistance++) {
+        vector<int> &bucket = buckets[currentDistance % numberOfBuckets];
+
+        // 0-weighted edges may add nodes to the bucket being processed,
+        // which is why its size is checked again at every step
+        for (int i = 0; i < (int) bucket.size(); i++) {
+            int currentNode = bucket[i];
+            numberOfPendingNodes--;
+
+            // the node was moved to a closer bucket after being pushed in this one,
+            // or was pushed twice in this very bucket (by 0-weighted edges)
+            if (isSettled[currentNode] or distanceFromSource[currentNode] != currentDistance)
+                continue;
+            isSettled[currentNode] = true;
+
+            for (auto &adjacentNode: adjacencyList[currentNode]) {
+                int node = adjacentNode.first, weight = adjacentNode.second;
+
+                if (not isSettled[node] and (distanceFromSource[node] == -1 or
+                                             currentDistance + weight < distanceFromSource[node])) {
+                    parentOf[node] = currentNode;
+                    distanceFromSource[node] = currentDistance + weight;
+                    buckets[distanceFromSource[node] % numberOfBuckets].push_back(node);
+                    numberOfPendingNodes++;
+                }
+            }
+        }
+
+        bucket.clear();
+    }
+}
+
+
+// Dijkstra's algorithm with a binary heap, for weights too large to get a bucket each;
+// outdated entries of the heap are skipped when popped, as in 'smallWeightBFS'
+void heapDijkstra(int sourceNode, int numberOfNodes, const vector<vector<pair<int, int>>> &adjacencyList,
+                  int *parentOf, long long *distanceFromSource) {
+    for (int i = 0; i < numberOfNodes; i++) {
+        parentOf[i] = -1;
+        distanceFromSource[i] = -1;
+    }
+
+    bool isSettled[numberOfNodes];
+    for (int i = 0; i < numberOfNodes; i++)
+        isSettled[i] = false;
+
+    // pairs of (distance, node), smallest distance first
+    priority_queue<pair<long long, int>, vector<pair<long long, int>>, greater<>> heap;
+
+    distanceFromSource[sourceNode] = 0;
+    heap.emplace(0, sourceNode);
+
+    while (not heap.empty()) {
+        long long currentDistance = heap.top().first;
+        int currentNode = heap.top().second;
+        heap.pop();
+
+        if (isSettled[currentNode] or distanceFromSource[currentNode] != currentDistance)
+            continue;
+        isSettled[currentNode] = true;
+
+        for (auto &adjacentNode: adjacencyList[currentNode]) {
+            int node = adjacentNode.first, weight = adjacentNode.second;
+
+            if (not isSettled[node] and (distanceFromSource[node] == -1 or
+                                         currentDistance + weight < distanceFromSource[node])) {
+                parentOf[node] = currentNode;
+                distanceFromSource[node] = currentDistance + weight;
+                heap.emplace(distanceFromSource[node], node);
+            }
+        }
+    }
+}
+
+
+int main() {
+    ifstream input("graf.in");
+
+    int numberOfNodes, numberOfEdges, sourceNode;
+    input >> numberOfNodes >> numberOfEdges;
+
+    vector<vector<pair<int, int>>> adjacencyList(numberOfNodes, vector<pair<int, int>>());
+    int firstNode, secondNode, weight, maximumWeight = 0;
+    for (int i = 0; i < numberOfEdges; i++) {
+        input >> firstNode >> secondNode >> weight;
+        // none of the three searches can handle negative weights, since they settle a node for good
+        // the first time they pop it
+        if (weight < 0) {
+            cerr << "edge " << i + 1 << " has a negative weight\n";
+            return 1;
+        }
+        firstNode--;
+        secondNode--;
+
+        adjacencyList[firstNode].emplace_back(secondNode, weight);
+        adjacencyList[secondNode].emplace_back(firstNode, weight);
+        maximumWeight = max(maximumWeight, weight);
+    }
+
+    input >> sourceNode;
+    sourceNode--;
+
+    input.close();
+
+    int parentOf[numberOfNodes];
+    long long distances[numberOfNodes];
+
+    // the double-ended queue is enough whenever no weight exceeds 1,
+    // and the buckets whenever there aren't too many of them
+    if (maximumWeight <= 1)
+        zeroOneBFS(sourceNode, numberOfNodes, adjacencyList, parentOf, distances);
+    else if (maximumWeight < MAXIMUM_NUMBER_OF_BUCKETS)
+        smallWeightBFS(sourceNode, numberOfNodes, adjacencyList, maximumWeight, parentOf, distances);
+    else
+        heapDijkstra(sourceNode, numberOfNodes, adjacencyList, parentOf, distances);
+
+    // display edges in tree
+    for (int node = 0; node < numberOfNodes; node++)
+        if (node != sourceNode and parentOf[node] != -1)
+            cout << node + 1 << ' ' << parentOf[node] + 1 << '\n';
+
+    return 0;
+}